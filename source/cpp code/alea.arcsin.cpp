@@ -1,4 +1,8 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_icdf.h"
 #include <random>
 #include <array>
 
@@ -21,8 +25,7 @@ public:
           m_alpha(args.size() > 0 ? static_cast<double>(args[0]) : 1.0),
           m_beta(args.size() > 1 ? static_cast<double>(args[1]) : 0.0) {
 
-        std::random_device rd;
-        set_seed(rd());
+        set_seed(alea::random_seed());
     }
 
     message<> bang {this, "bang", "Generate and output a random number",
@@ -77,6 +80,7 @@ public:
             if (!args.empty()) {
                 set_seed(static_cast<uint32_t>(static_cast<int>(args[0])));
                 cout << "Seed set to: " << m_seed << endl;
+                cout << "Engine set to: " << m_gen.name() << endl;
             }
             return {};
         }
@@ -105,12 +109,31 @@ public:
     };
 
 private:
-    std::mt19937 m_gen;
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_arcsin>;
+
+    void reseed(uint32_t s) { set_seed(s); }
+    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }
+    void sample() { generate_random_number(); }
+
+    // The standard variate of @fast, from the shared table for the current parameters.
+    double table_variate(double u) {
+        if (!m_table) {
+            m_table = alea::icdf_table::shared("arcsin", 0.0, fasterror, [](double v) {
+                double g = std::sin(3.141592653589793238462643 * v) / 2.0;
+                return g * g;
+            });
+        }
+        return (*m_table)(u);
+    }
+
+    alea::engine m_gen;
     uint32_t m_seed;
     int m_mode;
     int m_input;
     int m_type;
     long m_arcsin_count;
+    std::shared_ptr<const alea::icdf_table> m_table;  // @fast, built on the next value after a change
     double m_alpha;
     double m_beta;
     double m_rand;
@@ -124,6 +147,7 @@ private:
     }
 
     void generate_random_number() {
+        m_gen.begin_sample();
         m_arcsin_count++;
         double temp = 0.0;
 
@@ -132,12 +156,16 @@ private:
             m = (m * 1103515245 + 12345) & 2147483647;
             temp = (static_cast<double>(m) + 0.5) / 2147483648.0;
         } else {
-            std::uniform_real_distribution<> dis(0.0, 1.0);
-            temp = dis(m_gen);
+            temp = m_gen.uniform();
         }
 
-        double g = std::sin(3.141592653589793238462643 * temp) / 2.0;
-        double n = (g * g * m_alpha) + m_beta;
+        double n;
+        if (fast) {
+            n = (table_variate(temp) * m_alpha) + m_beta;
+        } else {
+            double g = std::sin(3.141592653589793238462643 * temp) / 2.0;
+            n = (g * g * m_alpha) + m_beta;
+        }
 
         if (m_mode == 1) {
             n = std::round(n);
@@ -146,6 +174,22 @@ private:
             output.send(n);
         }
     }
+
+public:
+    alea::engine_messages<alea_arcsin> m_engine_messages {this, m_gen, output};
+
+    attribute<bool> fast {this, "fast", false,
+        description {"Sample a table of the inverse CDF instead of calling sin on every value: several times faster, within @fasterror"}
+    };
+
+    attribute<double> fasterror {this, "fasterror", 1e-6,
+        description {"Largest error of @fast, relative to the value before alpha and beta (absolute below 1); the table is rebuilt on the next value"},
+        setter { MIN_FUNCTION {
+            double e = args[0];
+            m_table.reset();
+            return {std::max(e, 1e-12)};
+        }}
+    };
 };
 
 MIN_EXTERNAL(alea_arcsin);
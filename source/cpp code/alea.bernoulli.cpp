@@ -1,5 +1,12 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_bernoulli.h"
 #include <random>
+#include <algorithm>
+#include <vector>
 
 using namespace c74::min;
 
@@ -23,9 +30,10 @@ public:
                 p = static_cast<double>(args[0].a_w.w_long);
             }
         }
+        m_words.set(p);
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -40,6 +48,7 @@ public:
         MIN_FUNCTION {
             if (inlet == 1) {
                 p = args[0];
+                m_words.set(p);
             }
             return {};
         }
@@ -49,11 +58,24 @@ public:
         MIN_FUNCTION {
             if (inlet == 1) {
                 p = static_cast<double>(args[0].a_w.w_long);
+                m_words.set(p);
             }
             return {};
         }
     };
 
+    message<> pattern {this, "pattern", "Output N trials at once as a list of 0 and 1, 64 trials from a few engine words",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count();
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "pattern needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            generate_pattern(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
     message<> seed_msg {this, "seed", "Set seed value",
         MIN_FUNCTION {
             seed_value = static_cast<unsigned long>(args[0]);
@@ -67,21 +89,56 @@ public:
             cout << "state:" << endl;
             cout << "  p: " << p << endl;
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_bernoulli>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
     void generate_random_value() {
+        m_generator.begin_sample();
         std::bernoulli_distribution dist(p);
         bernoulli_result = dist(m_generator);
         output.send(bernoulli_result);
     }
 
-    std::mt19937 m_generator;
+    void generate_pattern(long count) {
+        m_pattern.resize(static_cast<size_t>(count));
+        if (m_generator.counter_based()) {
+            // one sample index per trial, so that seek and sample_at still address trials
+            for (int& trial : m_pattern) {
+                m_generator.begin_sample();
+                trial = std::bernoulli_distribution(p)(m_generator);
+            }
+        } else {
+            for (size_t i = 0; i < m_pattern.size(); i += 64) {
+                const uint64_t word = m_words(m_generator);
+                const size_t n = std::min<size_t>(64, m_pattern.size() - i);
+                for (size_t bit = 0; bit < n; ++bit) {
+                    m_pattern[i + bit] = static_cast<int>((word >> bit) & 1u);
+                }
+            }
+        }
+        bernoulli_result = m_pattern.back();
+        output.send(atoms(m_pattern.begin(), m_pattern.end()));
+    }
+
+    alea::engine m_generator;
     double p {0.5};  // Probability parameter
     int bernoulli_result {0};
-    unsigned long seed_value {std::random_device{}()};
+    alea::bernoulli_words m_words {p};  // p as bits for pattern, set when p changes
+    std::vector<int> m_pattern;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_bernoulli> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_bernoulli);
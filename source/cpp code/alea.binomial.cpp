@@ -0,0 +1,127 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_binomial.h"
+
+using namespace c74::min;
+
+class alea_binomial : public object<alea_binomial> {
+public:
+    MIN_DESCRIPTION {"Generates random values from a binomial distribution: the number of successes in n trials of probability p"};
+    MIN_TAGS {"random, distribution"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.bernoulli alea.geometric alea.negbin alea.poisson"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    inlet<> n_inlet {this, "(int) Set number of trials (n)"};
+    inlet<> p_inlet {this, "(float) Set probability parameter (p)"};
+    outlet<> output {this, "(int) Output random value"};
+
+    alea_binomial(const atoms& args = {}) {
+        if (args.size() > 0) {
+            set_n(static_cast<long>(args[0]));
+        }
+        if (args.size() > 1) {
+            set_p(static_cast<double>(args[1]));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Set number of trials (n) or probability parameter (p)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_n(static_cast<long>(static_cast<double>(args[0])));
+            }
+            else if (inlet == 2) {
+                set_p(args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Set number of trials (n) or probability parameter (p)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_n(static_cast<long>(args[0].a_w.w_long));
+            }
+            else if (inlet == 2) {
+                set_p(static_cast<double>(args[0].a_w.w_long));
+            }
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_binomial state:" << endl;
+            cout << "  n: " << n << endl;
+            cout << "  p: " << p << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_binomial>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        binomial_result = static_cast<long>(m_sampler(m_generator));
+        output.send(binomial_result);
+    }
+
+    void set_n(long value) {
+        if (value < 0) {
+            cerr << "alea_binomial: n must be >= 0" << endl;
+            return;
+        }
+        n = value;
+        m_sampler.set(n, p);
+    }
+
+    void set_p(double value) {
+        if (value < 0.0 || value > 1.0) {
+            cerr << "alea_binomial: p must be between 0 and 1" << endl;
+            return;
+        }
+        p = value;
+        m_sampler.set(n, p);
+    }
+
+    alea::engine m_generator;
+    long n {1};      // Number of trials
+    double p {0.5};  // Probability parameter
+    alea::binomial_sampler m_sampler {n, p};  // setup for n and p, redone when they change
+    long binomial_result {0};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_binomial> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_binomial);
@@ -1 +1 @@
-#include "c74_min.h"#include <random>using namespace c74::min;class alea_brownie : public object<alea_brownie> {public:    MIN_DESCRIPTION{"Generates a Brownian motion value within specified boundaries"};    MIN_TAGS{"random, brownian"};    MIN_AUTHOR{"Carl Faia"};    MIN_RELATED{"random"};    inlet<> input_bang {this, "(bang) Generate Brownian motion value"};    inlet<> input_start {this, "(float/int) Start value"};    inlet<> input_low {this, "(float/int) Low limit"};    inlet<> input_high {this, "(float/int) High limit"};    inlet<> input_bandwidth {this, "(float) Bandwidth"};    outlet<> output {this, "(float/int) Brownian motion value"};    alea_brownie(const atoms& args = {}) {        if (args.size() > 0) m_start = atom_to_double(args[0]);        if (args.size() > 1) m_low = atom_to_double(args[1]);        if (args.size() > 2) m_high = atom_to_double(args[2]);        if (args.size() > 3) m_bandwidth = atom_to_double(args[3]);        if (args.size() > 4) {            set_seed(static_cast<uint32_t>(static_cast<long>(args[4])));        } else {            set_seed(std::random_device{}());        }    }    message<> bang {this, "bang", "Generate and output Brownian motion value",        MIN_FUNCTION {            generate_brownian();            return {};        }    };    message<> float_input {this, "float", "Set start, low, high, or bandwidth value",        MIN_FUNCTION {            handle_input(args[0], inlet);            return {};        }    };    message<> int_input {this, "int", "Set start, low, high, or bandwidth value",        MIN_FUNCTION {            handle_input(static_cast<double>(args[0].a_w.w_long), inlet);            return {};        }    };    message<> seed {this, "seed", "Set the random seed",        MIN_FUNCTION {            if (!args.empty()) {                set_seed(static_cast<uint32_t>(static_cast<long>(args[0])));            }            return {};        }    };    message<> info {this, "info", "Print current state information",        MIN_FUNCTION {            cout << "Start: " << m_start << endl;            cout << "Low: " << m_low << endl;            cout << "High: " << m_high << endl;            cout << "Bandwidth: " << m_bandwidth << endl;            cout << "Seed: " << m_seed << endl;            return {};        }    };private:    std::mt19937 m_gen;    uint32_t m_seed;    double m_start {51.75};    double m_low {25.75};    double m_high {115.5};    double m_bandwidth {2.1};    bool m_type {false};    void set_seed(uint32_t seed) {        m_seed = seed;        m_gen.seed(seed);    }    void generate_brownian() {        std::normal_distribution<> dist(0.0, m_bandwidth);        double step = dist(m_gen);        double new_value = m_start + step;        if (new_value > m_high) {            new_value = 2 * m_high - new_value;        } else if (new_value < m_low) {            new_value = 2 * m_low - new_value;        }        m_start = new_value;        if (m_type) {            output.send(static_cast<int>(new_value + 0.5));        } else {            output.send(new_value);        }    }    void handle_input(double value, int inlet) {        switch (inlet) {            case 1: m_start = value; m_type = false; break;            case 2: m_low = value; break;            case 3: m_high = value; break;            case 4: m_bandwidth = value; break;        }    }    double atom_to_double(const atom& a) {        return (a.a_type == c74::max::A_FLOAT) ? static_cast<double>(a.a_w.w_float) : static_cast<double>(a.a_w.w_long);    }};MIN_EXTERNAL(alea_brownie);
\ No newline at end of file
+#include "c74_min.h"#include "alea_engine.h"#include "alea_seedgroup.h"#include "alea_engine_messages.h"#include "alea_list.h"#include "alea_normal.h"#include "alea_truncnorm.h"#include <cmath>#include <vector>using namespace c74::min;class alea_brownie : public object<alea_brownie> {public:    MIN_DESCRIPTION{"Generates a Brownian motion value within specified boundaries"};    MIN_TAGS{"random, brownian"};    MIN_AUTHOR{"Carl Faia"};    MIN_RELATED{"random"};    inlet<> input_bang {this, "(bang) Generate Brownian motion value"};    inlet<> input_start {this, "(float/int) Start value"};    inlet<> input_low {this, "(float/int) Low limit"};    inlet<> input_high {this, "(float/int) High limit"};    inlet<> input_bandwidth {this, "(float) Bandwidth"};    outlet<> output {this, "(float/int) Brownian motion value"};    alea_brownie(const atoms& args = {}) {        if (args.size() > 0) m_start = atom_to_double(args[0]);        if (args.size() > 1) m_low = atom_to_double(args[1]);        if (args.size() > 2) m_high = atom_to_double(args[2]);        if (args.size() > 3) m_bandwidth = atom_to_double(args[3]);        if (args.size() > 4) {            set_seed(static_cast<uint32_t>(static_cast<long>(args[4])));        } else {            set_seed(alea::random_seed());        }    }    message<> bang {this, "bang", "Generate and output Brownian motion value",        MIN_FUNCTION {            generate_brownian();            return {};        }    };    message<> generate {this, "generate", "Output the next N values of the walk at once as a list",        MIN_FUNCTION {            const long limit = alea::max_list_count();            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {                cerr << "generate needs a count between 1 and " << limit << endl;                return {};            }            generate_list(static_cast<long>(args[0]));            return {};        }    };    message<> float_input {this, "float", "Set start, low, high, or bandwidth value",        MIN_FUNCTION {            handle_input(args[0], inlet);            return {};        }    };    message<> int_input {this, "int", "Set start, low, high, or bandwidth value",        MIN_FUNCTION {            handle_input(static_cast<double>(args[0].a_w.w_long), inlet);            return {};        }    };    message<> seed {this, "seed", "Set the random seed",        MIN_FUNCTION {            if (!args.empty()) {                set_seed(static_cast<uint32_t>(static_cast<long>(args[0])));            }            return {};        }    };    message<> info {this, "info", "Print current state information",        MIN_FUNCTION {            cout << "Start: " << m_start << endl;            cout << "Low: " << m_low << endl;            cout << "High: " << m_high << endl;            cout << "Bandwidth: " << m_bandwidth << endl;            cout << "Boundary: " << (m_reflect ? "reflect" : "truncate") << endl;            cout << "Seed: " << m_seed << endl;            cout << "Engine: " << m_gen.name() << endl;            return {};        }    };private:    // alea::engine_messages hooks    friend class alea::engine_messages<alea_brownie>;    void reseed(uint32_t s) { set_seed(s); }    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }    void sample() { generate_brownian(); }    // The position of the walk, kept after the engine words.    void save_words(alea::state_writer& w) const { w.put_double(m_start); }    bool load_words(alea::state_reader& r) {        m_start = r.get_double();        return true;    }    alea::engine m_gen;    uint32_t m_seed;    double m_start {51.75};    double m_low {25.75};    double m_high {115.5};    double m_bandwidth {2.1};    bool m_type {false};    bool m_reflect {false};    alea::truncated_normal m_step;    std::vector<double> m_steps;    void set_seed(uint32_t seed) {        m_seed = seed;        m_gen.seed(seed);    }    void generate_brownian() {        m_gen.begin_sample();        double new_value = m_reflect ? walk(alea::normal(m_gen, 0.0, m_bandwidth)) : truncated_walk();        if (m_type) {            output.send(static_cast<int>(new_value + 0.5));        } else {            output.send(new_value);        }    }    void generate_list(long count) {        if (!m_reflect) {            // each step depends on the position before it, so there is no batch of steps to draw            atoms values;            values.reserve(static_cast<size_t>(count));            for (long i = 0; i < count; ++i) {                if (m_gen.counter_based()) {                    m_gen.begin_sample();                }                double new_value = truncated_walk();                if (m_type) {                    values.push_back(static_cast<int>(new_value + 0.5));                } else {                    values.push_back(new_value);                }            }            output.send(values);            return;        }        m_steps.resize(static_cast<size_t>(count));        if (m_gen.counter_based()) {            // one sample index per value, so that seek and sample_at still address values            for (double& step : m_steps) {                m_gen.begin_sample();                step = alea::normal(m_gen, 0.0, m_bandwidth);            }        } else {            alea::normal(m_gen, m_steps.data(), m_steps.size(), 0.0, m_bandwidth);        }        atoms values;        values.reserve(m_steps.size());        for (double step : m_steps) {            double new_value = walk(step);            if (m_type) {                values.push_back(static_cast<int>(new_value + 0.5));            } else {                values.push_back(new_value);            }        }        output.send(values);    }    // Take one step, reflected at the limits as often as it takes to land    // between them, and return the new position.    double walk(double step) {        double new_value = m_start + step;        const double low = std::min(m_low, m_high);        const double high = std::max(m_low, m_high);        if (new_value > high || new_value < low) {            // reflecting back and forth is periodic: fold over two widths            const double width = high - low;            double offset = width > 0.0 ? std::fmod(new_value - low, 2 * width) : 0.0;            if (offset < 0.0) {                offset += 2 * width;            }            new_value = offset > width ? high - (offset - width) : low + offset;        }        m_start = new_value;        return new_value;    }    // Take one step drawn from the normal truncated to the limits around the    // current position, so that every position in range keeps the shape of a    // normal step, and return the new position.    double truncated_walk() {        m_step.set(m_start, m_bandwidth, m_low, m_high);        m_start = m_step(m_gen);        return m_start;    }    void handle_input(double value, int inlet) {        switch (inlet) {            case 1: m_start = value; m_type = false; break;            case 2: m_low = value; break;            case 3: m_high = value; break;            case 4: m_bandwidth = value; break;        }    }    double atom_to_double(const atom& a) {        return (a.a_type == c74::max::A_FLOAT) ? static_cast<double>(a.a_w.w_float) : static_cast<double>(a.a_w.w_long);    }public:    alea::engine_messages<alea_brownie> m_engine_messages {this, m_gen, output};    attribute<symbol> boundary {this, "boundary", "truncate",        description {"At the limits: truncate (the default) draws each step from the normal truncated to them; reflect mirrors the step back inside as many times as it takes to land between them"},        range {"truncate", "reflect"},        setter { MIN_FUNCTION {            const symbol name = args[0];            if (name == "reflect") {                m_reflect = true;            } else if (name == "truncate") {                m_reflect = false;            } else {                cerr << "Unknown boundary " << name << ", keeping " << (m_reflect ? "reflect" : "truncate") << endl;            }            return {symbol(m_reflect ? "reflect" : "truncate")};        }}    };};MIN_EXTERNAL(alea_brownie);
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <cmath>
 #include <random>
 #include <array>
@@ -18,12 +21,12 @@ public:
 
     alea_cauchypos(const atoms& args = {}) {
         if (args.size() >= 1) {
-            m_alpha = static_cast<double>(args[0]);
+            set_alpha(static_cast<double>(args[0]));
         }
         if (args.size() > 1) {
             set_seed(static_cast<uint32_t>(static_cast<int>(args[1])));
         } else {
-            set_seed(static_cast<uint32_t>(std::random_device{}()));
+            set_seed(alea::random_seed());
         }
     }
 
@@ -36,14 +39,14 @@ public:
 
     message<> float_input {this, "float", "Set alpha value",
         MIN_FUNCTION {
-            m_alpha = args[0];
+            set_alpha(args[0]);
             return {};
         }
     };
 
     message<> int_input {this, "int", "Set alpha value",
         MIN_FUNCTION {
-            m_alpha = static_cast<double>(args[0]);
+            set_alpha(static_cast<double>(args[0]));
             return {};
         }
     };
@@ -61,6 +64,7 @@ public:
         MIN_FUNCTION {
             cout << "Alpha: " << m_alpha << endl;
             cout << "Seed: " << m_seed << endl;
+            cout << "Engine: " << m_gen.name() << endl;
             cout << "Last value: " << m_last_value << endl;
             cout << "Count: " << m_count << endl;
             return {};
@@ -68,11 +72,31 @@ public:
     };
 
 private:
-    std::mt19937 m_gen;
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_cauchypos>;
+
+    void reseed(uint32_t s) { set_seed(s); }
+    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }
+    void sample() { generate_random(); }
+
+    alea::engine m_gen;
     uint32_t m_seed;
     long m_count{0};
     double m_last_value{0.0};
     double m_alpha{1.0};
+    struct prepared {
+        double alpha{1.0};  // m_alpha, or a tiny scale for 0
+    } m_prepared;
+
+    // Alpha 0 would only give 0, so it is replaced once here, not checked per value.
+    void set_alpha(double alpha) {
+        m_alpha = alpha;
+        m_prepared.alpha = alpha;
+        if (alpha == 0) {
+            error("alea-cauchypos : alpha = 0");
+            m_prepared.alpha = 0.00000001;
+        }
+    }
 
     void set_seed(uint32_t s) {
         if (m_seed != s) {
@@ -83,22 +107,21 @@ private:
     }
 
     void generate_random() {
+        m_gen.begin_sample();
         m_count++;
         double temp;
-        double g = m_alpha;
+        double g = m_prepared.alpha;
         const double pi_half = 3.141592653589793238462643 * 0.5;
 
-        if (g == 0) {
-            error("alea-cauchypos : alpha = 0");
-            g = 0.00000001;
-        }
-
         double u = std::generate_canonical<double, 32>(m_gen) * pi_half;
         double n = g * std::tan(u);
 
         m_last_value = n;
         output.send(n);
     }
+
+public:
+    alea::engine_messages<alea_cauchypos> m_engine_messages {this, m_gen, output};
 };
 
 MIN_EXTERNAL(alea_cauchypos);
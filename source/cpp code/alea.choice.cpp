@@ -1,4 +1,7 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
 
 using namespace c74::min;
@@ -36,7 +39,8 @@ public:
                 m_choice_B = {args[2]};
             }
         }
-        m_generator.seed(std::random_device{}());
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
     }
 
     message<> bang {this, "bang", "Generate random choice",
@@ -90,10 +94,35 @@ public:
         }
     };
 
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_choice state:" << endl;
+            cout << "  weight: " << weight << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_choice>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { make_choice(); }
+
     void make_choice() {
-        std::uniform_real_distribution<double> distribution(0.0, 1.0);
-        double random_value = distribution(m_generator);
+        m_generator.begin_sample();
+        double random_value = m_generator.uniform();
 
         if (random_value < weight) {
             output_choice(m_choice_A);
@@ -119,9 +148,13 @@ private:
         }
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     atoms m_choice_A;
     atoms m_choice_B;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_choice> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_choice);
\ No newline at end of file
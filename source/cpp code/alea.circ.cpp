@@ -1,4 +1,7 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
 #include <cmath>
 
@@ -24,7 +27,8 @@ public:
             arc = args[1];
         }
 
-        generator.seed(std::random_device{}());
+        seed = alea::random_seed();
+        generator.seed(seed);
     }
 
     message<> bang {this, "bang", "Generate random value",
@@ -70,14 +74,22 @@ public:
             cout << "  mean: " << mean << endl;
             cout << "  arc: " << arc << endl;
             cout << "  seed: " << seed << endl;
+            cout << "  engine: " << generator.name() << ", stream " << generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_circ>;
+
+    void reseed(uint32_t s) { seed = s; generator.seed(seed); }
+    void restore_seed(uint64_t s) { seed = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
     void generate_random_value() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double random_value = dist(generator);
+        generator.begin_sample();
+        double random_value = generator.uniform();
 
         double g = (mean + arc * (random_value - 0.5));
         double n = g / 3;
@@ -88,11 +100,14 @@ private:
         output.send(result);
     }
 
-    std::mt19937 generator;
+    alea::engine generator;
     double mean = 0.0;
     double arc = 1.0;
-    unsigned long seed = std::random_device{}();
+    unsigned long seed = 0;
     const double pi = 3.141592653589793238462643383279502884;
+
+public:
+    alea::engine_messages<alea_circ> m_engine_messages {this, generator, output};
 };
 
 MIN_EXTERNAL(alea_circ);
@@ -0,0 +1,290 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_empirical.h"
+#include <vector>
+#include <atomic>
+
+using namespace c74::min;
+
+class alea_custom : public object<alea_custom> {
+public:
+    MIN_DESCRIPTION {"Generates random values from a distribution drawn or measured as weights, from a list, a table or a buffer~"};
+    MIN_TAGS {"random, distribution, histogram, empirical, table, buffer"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.mchoice, table, buffer~"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    outlet<> output {this, "(float/int) Output random value, or bin with @mode bin"};
+
+    alea_custom(const atoms& args = {}) {
+        if (!args.empty()) {
+            set_buffer(args);
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            if (!ready()) {
+                return {};
+            }
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random values at once as a list",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count();
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            if (!ready()) {
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> weights {this, "weights", "Use these weights, one per bin",
+        MIN_FUNCTION {
+            std::vector<double> values(args.size());
+            for (size_t i = 0; i < args.size(); ++i) {
+                values[i] = static_cast<double>(args[i]);
+            }
+            m_source = source::list;
+            load(values);
+            return {};
+        }
+    };
+
+    message<> table {this, "table", "Use the values of the named table object as weights, read now and on refresh",
+        MIN_FUNCTION {
+            if (args.empty()) {
+                cerr << "alea_custom: table needs a table name" << endl;
+                return {};
+            }
+            m_source = source::table;
+            m_name = args[0];
+            load_table();
+            return {};
+        }
+    };
+
+    message<> buffer {this, "buffer", "Use the samples of the named buffer~ as weights, channel 1 or the given one; reread when the buffer~ changes",
+        MIN_FUNCTION {
+            set_buffer(args);
+            return {};
+        }
+    };
+
+    message<> refresh {this, "refresh", "Read the table or buffer~ again",
+        MIN_FUNCTION {
+            if (m_source == source::table) {
+                load_table();
+            } else if (m_source == source::buffer) {
+                load_buffer();
+            }
+            return {};
+        }
+    };
+
+    message<> quantile {this, "quantile", "Output the value below which the given share (0 to 1) of the weight lies",
+        MIN_FUNCTION {
+            if (args.empty() || !ready()) {
+                return {};
+            }
+            output.send(to_value(m_sampler.quantile(static_cast<double>(args[0]))));
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            static const char* sources[] = {"none", "list", "table", "buffer~"};
+            cout << "alea_custom state:" << endl;
+            cout << "  source: " << sources[static_cast<int>(m_source)];
+            if (m_source == source::table || m_source == source::buffer) {
+                cout << " " << m_name;
+            }
+            cout << endl;
+            cout << "  bins: " << m_sampler.bins() << endl;
+            cout << "  mode: " << (m_bins ? "bin" : "continuous") << ", limits " << m_low << " " << m_high << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    enum class source { none, list, table, buffer };
+
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_custom>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void set_buffer(const atoms& args) {
+        if (args.empty()) {
+            cerr << "alea_custom: buffer needs a buffer~ name" << endl;
+            return;
+        }
+        m_source = source::buffer;
+        m_name = args[0];
+        m_channel = args.size() > 1 ? std::max(1L, static_cast<long>(args[1])) - 1 : 0;
+        m_buffer.set(m_name);
+        ++m_buffer_changes;  // read on the next value
+    }
+
+    // Weights in, alias table and CDF out.
+    void load(const std::vector<double>& values) {
+        if (!m_sampler.set(values)) {
+            cerr << "alea_custom: no positive weight to draw from" << endl;
+        }
+    }
+
+    void load_table() {
+        long** handle = nullptr;
+        long size = 0;
+        if (c74::max::table_get(m_name, &handle, &size) != 0 || handle == nullptr || size <= 0) {
+            cerr << "alea_custom: no table named " << m_name << endl;
+            return;
+        }
+        m_weights.resize(static_cast<size_t>(size));
+        for (long i = 0; i < size; ++i) {
+            m_weights[static_cast<size_t>(i)] = static_cast<double>((*handle)[i]);
+        }
+        load(m_weights);
+    }
+
+    void load_buffer() {
+        m_loaded_changes = m_buffer_changes;
+        buffer_lock<false> samples {m_buffer};
+        if (!samples.valid() || samples.frame_count() == 0) {
+            cerr << "alea_custom: no buffer~ named " << m_name << endl;
+            return;
+        }
+        const size_t channel = std::min(m_channel, samples.channel_count() - 1);
+        m_weights.resize(samples.frame_count());
+        for (size_t i = 0; i < m_weights.size(); ++i) {
+            m_weights[i] = samples.lookup(i, channel);
+        }
+        load(m_weights);
+    }
+
+    // A buffer~ is reread only when it has changed since the last read.
+    bool ready() {
+        if (m_source == source::buffer && m_loaded_changes != m_buffer_changes) {
+            load_buffer();
+        }
+        if (m_sampler.empty()) {
+            cerr << "alea_custom: no weights, use weights, table or buffer" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // A position in [0, bins] to the output range.
+    atom to_value(double position) const {
+        if (m_bins) {
+            return static_cast<long>(std::min(position, static_cast<double>(m_sampler.bins() - 1)));
+        }
+        return m_low + (m_high - m_low) * (position / static_cast<double>(m_sampler.bins()));
+    }
+
+    atom draw() {
+        if (m_bins) {
+            return static_cast<long>(m_sampler.bin(m_generator));
+        }
+        return to_value(m_sampler(m_generator));
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        output.send(draw());
+    }
+
+    void generate_list(long count) {
+        m_batch.resize(static_cast<size_t>(count));
+        for (atom& value : m_batch) {
+            if (m_generator.counter_based()) {
+                // one sample index per value, so that seek and sample_at still address values
+                m_generator.begin_sample();
+            }
+            value = draw();
+        }
+        output.send(m_batch);
+    }
+
+    alea::engine m_generator;
+    alea::empirical_sampler m_sampler;  // alias table and CDF of the weights, set when they change
+    source m_source {source::none};
+    symbol m_name;
+    size_t m_channel {0};
+    std::vector<double> m_weights;
+    std::atomic<unsigned long> m_buffer_changes {0};  // counted by the buffer~ notifications
+    unsigned long m_loaded_changes {0};
+    buffer_reference m_buffer {this,
+        MIN_FUNCTION {
+            ++m_buffer_changes;
+            return {};
+        }
+    };
+    bool m_bins {false};
+    double m_low {0.0};
+    double m_high {1.0};
+    atoms m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_custom> m_engine_messages {this, m_generator, output};
+
+    attribute<symbol> mode {this, "mode", "continuous",
+        description {"continuous (default): values spread evenly inside each bin, between the limits; bin: the bin index, from 0"},
+        range {"continuous", "bin"},
+        setter { MIN_FUNCTION {
+            const symbol name = args[0];
+            if (name == "bin") {
+                m_bins = true;
+            } else if (name == "continuous") {
+                m_bins = false;
+            } else {
+                cerr << "Unknown mode " << name << ", keeping " << (m_bins ? "bin" : "continuous") << endl;
+            }
+            return {symbol(m_bins ? "bin" : "continuous")};
+        }}
+    };
+
+    attribute<atoms> limits {this, "limits", {0.0, 1.0},
+        description {"Low and high value of the continuous mode: the bins divide this range evenly"},
+        setter { MIN_FUNCTION {
+            if (args.size() != 2) {
+                cerr << "limits needs a low and a high value" << endl;
+                return {m_low, m_high};
+            }
+            m_low = args[0];
+            m_high = args[1];
+            return {m_low, m_high};
+        }}
+    };
+};
+
+MIN_EXTERNAL(alea_custom);
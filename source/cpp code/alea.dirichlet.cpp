@@ -0,0 +1,201 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_dirichlet.h"
+#include <vector>
+#include <algorithm>
+
+using namespace c74::min;
+
+class alea_dirichlet : public object<alea_dirichlet> {
+public:
+    MIN_DESCRIPTION {"Generates random probability vectors from a Dirichlet distribution"};
+    MIN_TAGS {"random, distribution, dirichlet, probability"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.gamma, alea.markov, alea.mchoice"};
+
+    inlet<> input {this, "(bang) Generate random probability vector"};
+    inlet<> alpha_inlet {this, "(float) Set the same alpha for every component"};
+    outlet<> output {this, "(list) Output random probability vector"};
+
+    alea_dirichlet(const atoms& args = {}) {
+        if (args.size() > 0) {
+            set_size(static_cast<long>(args[0]));
+        }
+        if (args.size() > 1) {
+            set_alpha(static_cast<double>(args[1]));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random probability vector",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random probability vectors at once as one list, vector after vector",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count(m_sampler.size());
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Set the same alpha for every component",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_alpha(args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Set the same alpha for every component",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_alpha(static_cast<double>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> size {this, "size", "Set the number of components, all with the alpha of the first",
+        MIN_FUNCTION {
+            if (!args.empty()) {
+                set_size(static_cast<long>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> alpha {this, "alpha", "Set one alpha for every component, or one alpha per component (which also sets the size)",
+        MIN_FUNCTION {
+            if (args.size() == 1) {
+                set_alpha(static_cast<double>(args[0]));
+            } else if (args.size() > 1) {
+                set_alphas(args);
+            }
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_dirichlet state:" << endl;
+            cout << "  size: " << m_alphas.size() << endl;
+            cout << "  alpha:";
+            for (double a : m_alphas) {
+                cout << " " << a;
+            }
+            cout << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_dirichlet>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void set_size(long value) {
+        if (value < 1) {
+            cerr << "alea_dirichlet: size must be >= 1" << endl;
+            return;
+        }
+        m_alphas.assign(static_cast<size_t>(value), m_alphas.front());
+        prepare();
+    }
+
+    void set_alpha(double value) {
+        if (value <= 0.0) {
+            cerr << "alea_dirichlet: alpha must be > 0" << endl;
+            return;
+        }
+        std::fill(m_alphas.begin(), m_alphas.end(), value);
+        prepare();
+    }
+
+    void set_alphas(const atoms& args) {
+        std::vector<double> values(args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+            values[i] = static_cast<double>(args[i]);
+            if (values[i] <= 0.0) {
+                cerr << "alea_dirichlet: every alpha must be > 0" << endl;
+                return;
+            }
+        }
+        m_alphas = values;
+        prepare();
+    }
+
+    // One gamma sampler when every alpha is the same, and buffers sized once
+    // per size, so that a bang does not allocate.
+    void prepare() {
+        if (std::all_of(m_alphas.begin(), m_alphas.end(), [this](double a) { return a == m_alphas.front(); })) {
+            m_sampler.set(m_alphas.front(), m_alphas.size());
+        } else {
+            m_sampler.set(m_alphas);
+        }
+        m_vector.assign(m_alphas.size(), 0.0);
+        m_atoms.assign(m_alphas.size(), atom(0.0));
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        m_sampler(m_generator, m_vector.data());
+        for (size_t i = 0; i < m_vector.size(); ++i) {
+            m_atoms[i] = m_vector[i];
+        }
+        output.send(m_atoms);
+    }
+
+    void generate_list(long count) {
+        const size_t k = m_sampler.size();
+        m_batch.resize(static_cast<size_t>(count) * k);
+        for (size_t v = 0; v < static_cast<size_t>(count); ++v) {
+            if (m_generator.counter_based()) {
+                // one sample index per vector, so that seek and sample_at still address vectors
+                m_generator.begin_sample();
+            }
+            m_sampler(m_generator, m_batch.data() + v * k);
+        }
+        output.send(atoms(m_batch.begin(), m_batch.end()));
+    }
+
+    alea::engine m_generator;
+    std::vector<double> m_alphas {1.0, 1.0, 1.0};
+    alea::dirichlet_sampler m_sampler {1.0, 3};  // gamma samplers for the alphas, set when they change
+    std::vector<double> m_vector {0.0, 0.0, 0.0};
+    atoms m_atoms {0.0, 0.0, 0.0};
+    std::vector<double> m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_dirichlet> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_dirichlet);
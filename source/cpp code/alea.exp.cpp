@@ -1,5 +1,9 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
+#include <cmath>
 
 using namespace c74::min;
 
@@ -20,7 +24,7 @@ public:
         }
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -53,6 +57,7 @@ public:
     message<> info {this, "info", "Get object info",
         MIN_FUNCTION {
             cout << "alea-exp: seed = " << seed_value << endl;
+            cout << "alea-exp: engine = " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             cout << "alea-exp: lambda = " << exp_lambda << endl;
             cout << "alea-exp: last generated value = " << last_value << endl;
             return {};
@@ -60,9 +65,16 @@ public:
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_exp>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
     void generate_random_value() {
-        std::exponential_distribution<> distribution(exp_lambda);
-        last_value = distribution(m_generator);
+        m_generator.begin_sample();
+        last_value = -std::log(1.0 - m_generator.uniform()) * m_prepared.inv_lambda;
         output.send(last_value);
     }
 
@@ -73,12 +85,19 @@ private:
         } else {
             exp_lambda = lambda;
         }
+        m_prepared.inv_lambda = 1.0 / exp_lambda;
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
+    struct prepared {
+        double inv_lambda {1.0};  // the mean, so a value is a multiplication
+    } m_prepared;
     double exp_lambda {1.0};
     double last_value {0.0};
     unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_exp> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_exp);
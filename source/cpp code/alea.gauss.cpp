@@ -1,5 +1,11 @@
 #include "c74_min.h"
-#include <random>
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_normal.h"
+#include "alea_truncnorm.h"
+#include <vector>
 
 using namespace c74::min;
 
@@ -24,7 +30,7 @@ public:
         }
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -35,6 +41,18 @@ public:
         }
     };
 
+    message<> generate {this, "generate", "Output N random values at once as a list",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count();
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
     message<> float_msg {this, "float", "Set sigma or mu value",
         MIN_FUNCTION {
             if (inlet == 1) {
@@ -60,20 +78,55 @@ public:
     message<> info {this, "info", "Get object info",
         MIN_FUNCTION {
             cout << "alea-gauss: seed = " << seed_value << endl;
+            cout << "alea-gauss: engine = " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             cout << "alea-gauss: sigma = " << sigma << endl;
             cout << "alea-gauss: mu = " << mu << endl;
+            if (m_bounded) {
+                cout << "alea-gauss: bounds = " << m_low << " " << m_high << endl;
+            } else {
+                cout << "alea-gauss: bounds = none" << endl;
+            }
             cout << "alea-gauss: last generated value = " << last_value << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_gauss>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
     void generate_random_value() {
-        std::normal_distribution<> distribution(mu, sigma);
-        last_value = distribution(m_generator);
+        m_generator.begin_sample();
+        last_value = m_bounded ? m_truncated(m_generator) : alea::normal(m_generator, mu, sigma);
         output.send(last_value);
     }
 
+    void generate_list(long count) {
+        m_batch.resize(static_cast<size_t>(count));
+        if (m_bounded) {
+            for (double& value : m_batch) {
+                if (m_generator.counter_based()) {
+                    m_generator.begin_sample();
+                }
+                value = m_truncated(m_generator);
+            }
+        } else if (m_generator.counter_based()) {
+            // one sample index per value, so that seek and sample_at still address values
+            for (double& value : m_batch) {
+                m_generator.begin_sample();
+                value = alea::normal(m_generator, mu, sigma);
+            }
+        } else {
+            alea::normal(m_generator, m_batch.data(), m_batch.size(), mu, sigma);
+        }
+        last_value = m_batch.back();
+        output.send(atoms(m_batch.begin(), m_batch.end()));
+    }
+
     void set_sigma(double value) {
         if (value <= 0.0) {
             cerr << "Error: sigma must be greater than 0. Setting sigma to default value 0.7." << endl;
@@ -81,17 +134,46 @@ private:
         } else {
             sigma = value;
         }
+        m_truncated.set(mu, sigma, m_low, m_high);
     }
 
     void set_mu(double value) {
         mu = value;
+        m_truncated.set(mu, sigma, m_low, m_high);
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     double sigma {0.7};
     double mu {0.9};
     double last_value {0.0};
+    bool m_bounded {false};
+    double m_low {0.0};
+    double m_high {0.0};
+    alea::truncated_normal m_truncated;
+    std::vector<double> m_batch;
     unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_gauss> m_engine_messages {this, m_generator, output};
+
+    attribute<atoms> bounds {this, "bounds", {},
+        description {"Low and high limit: values are drawn from the normal truncated to them, in constant time even far in the tail; empty for none"},
+        setter { MIN_FUNCTION {
+            if (args.empty()) {
+                m_bounded = false;
+                return {};
+            }
+            if (args.size() != 2) {
+                cerr << "bounds needs a low and a high limit, or nothing to remove them" << endl;
+                return m_bounded ? atoms {m_low, m_high} : atoms {};
+            }
+            m_low = std::min<double>(args[0], args[1]);
+            m_high = std::max<double>(args[0], args[1]);
+            m_bounded = true;
+            m_truncated.set(mu, sigma, m_low, m_high);
+            return {m_low, m_high};
+        }}
+    };
 };
 
 MIN_EXTERNAL(alea_gauss);
@@ -0,0 +1,106 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_binomial.h"
+
+using namespace c74::min;
+
+class alea_geometric : public object<alea_geometric> {
+public:
+    MIN_DESCRIPTION {"Generates random values from a geometric distribution: the number of failures before the first success of probability p"};
+    MIN_TAGS {"random, distribution"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.bernoulli alea.binomial alea.negbin"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    inlet<> p_inlet {this, "(float) Set probability parameter (p)"};
+    outlet<> output {this, "(int) Output random value"};
+
+    alea_geometric(const atoms& args = {}) {
+        if (args.size() > 0) {
+            set_p(static_cast<double>(args[0]));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Set probability parameter (p)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_p(args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Set probability parameter (p)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_p(static_cast<double>(args[0].a_w.w_long));
+            }
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_geometric state:" << endl;
+            cout << "  p: " << p << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_geometric>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        geometric_result = static_cast<long>(m_sampler(m_generator));
+        output.send(geometric_result);
+    }
+
+    void set_p(double value) {
+        if (value <= 0.0 || value > 1.0) {
+            cerr << "alea_geometric: p must be > 0 and <= 1" << endl;
+            return;
+        }
+        p = value;
+        m_sampler.set(p);
+    }
+
+    alea::engine m_generator;
+    double p {0.5};  // Probability parameter
+    alea::geometric_sampler m_sampler {p};  // log(1 - p), redone when p changes
+    long geometric_result {0};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_geometric> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_geometric);
@@ -1 +1 @@
-#include "c74_min.h"#include <random>#include <cmath>using namespace c74::min;class alea_hypercos : public object<alea_hypercos> {public:    MIN_DESCRIPTION {"Generates random values based on a hyperbolic cosine distribution"};    MIN_TAGS {"random, distribution, hyperbolic, cosine"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> a_inlet {this, "(float) Set 'a' value"};    inlet<> b_inlet {this, "(float) Set 'b' value"};    outlet<> output {this, "(float) Output random value"};    alea_hypercos(const atoms& args = {}) {        if (args.size() > 0 && args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            a = args[0];        }        if (args.size() > 1 && args[1].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            b = args[1];        }        // Initialize with a random seed        seed_value = std::random_device{}();        generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> float_msg {this, "float", "Set 'a' or 'b' value",        MIN_FUNCTION {            if (inlet == 1) {                a = args[0];            }            else if (inlet == 2) {                b = args[0];            }            return {};        }    };    message<> int_msg {this, "int", "Set seed value",        MIN_FUNCTION {            seed_value = args[0];            generator.seed(seed_value);            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = args[0];            generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_hypercos state:" << endl;            cout << "  a: " << a << endl;            cout << "  b: " << b << endl;            cout << "  seed: " << seed_value << endl;            return {};        }    };private:    void generate_random_value() {        std::uniform_real_distribution<double> dist(0.0, 1.0);        double random_value = dist(generator);        double g = std::tan(pi * random_value) / 2;        double n = ((std::log(g)) * a) + b;        double result = n;        output.send(result);    }    std::mt19937 generator;    double a = 0.5;    double b = 0.5;    unsigned long seed_value = std::random_device{}();    const double pi = 3.141592653589793238462643383279502884;};MIN_EXTERNAL(alea_hypercos);
\ No newline at end of file
+#include "c74_min.h"#include "alea_engine.h"#include "alea_seedgroup.h"#include "alea_engine_messages.h"#include "alea_icdf.h"#include <random>#include <cmath>using namespace c74::min;class alea_hypercos : public object<alea_hypercos> {public:    MIN_DESCRIPTION {"Generates random values based on a hyperbolic cosine distribution"};    MIN_TAGS {"random, distribution, hyperbolic, cosine"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> a_inlet {this, "(float) Set 'a' value"};    inlet<> b_inlet {this, "(float) Set 'b' value"};    outlet<> output {this, "(float) Output random value"};    alea_hypercos(const atoms& args = {}) {        if (args.size() > 0 && args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            a = args[0];        }        if (args.size() > 1 && args[1].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            b = args[1];        }        // Initialize with a random seed        seed_value = alea::random_seed();        generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> float_msg {this, "float", "Set 'a' or 'b' value",        MIN_FUNCTION {            if (inlet == 1) {                a = args[0];            }            else if (inlet == 2) {                b = args[0];            }            return {};        }    };    message<> int_msg {this, "int", "Set seed value",        MIN_FUNCTION {            seed_value = args[0];            generator.seed(seed_value);            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = args[0];            generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_hypercos state:" << endl;            cout << "  a: " << a << endl;            cout << "  b: " << b << endl;            cout << "  seed: " << seed_value << endl;            cout << "  engine: " << generator.name() << ", stream " << generator.stream_index() << endl;            return {};        }    };private:    // alea::engine_messages hooks    friend class alea::engine_messages<alea_hypercos>;    void reseed(uint32_t s) { seed_value = s; generator.seed(seed_value); }    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }    void sample() { generate_random_value(); }    // The standard variate of @fast, from the shared table for the current parameters.    double table_variate(double u) {        if (!m_table) {            m_table = alea::icdf_table::shared("hypercos", 0.0, fasterror, [](double v) {                const double pi = 3.141592653589793238462643383279502884;                return std::log(std::fabs(std::tan(pi * v)) / 2);            });        }        return (*m_table)(u);    }    void generate_random_value() {        generator.begin_sample();        double random_value = generator.uniform();        double n;        if (fast) {            n = (table_variate(random_value) * a) + b;        } else {            // |tan| folds u > 0.5, where tan is negative, onto u < 0.5            double g = std::fabs(std::tan(pi * random_value)) / 2;            n = ((std::log(g)) * a) + b;        }        double result = n;        output.send(result);    }    alea::engine generator;    std::shared_ptr<const alea::icdf_table> m_table;  // @fast, built on the next value after a change    double a = 0.5;    double b = 0.5;    unsigned long seed_value = 0;    const double pi = 3.141592653589793238462643383279502884;public:    alea::engine_messages<alea_hypercos> m_engine_messages {this, generator, output};    attribute<bool> fast {this, "fast", false,        description {"Sample a table of the inverse CDF instead of calling tan and log on every value: several times faster, within @fasterror"}    };    attribute<double> fasterror {this, "fasterror", 1e-6,        description {"Largest error of @fast, relative to the value before a and b (absolute below 1); the table is rebuilt on the next value"},        setter { MIN_FUNCTION {            double e = args[0];            m_table.reset();            return {std::max(e, 1e-12)};        }}    };};MIN_EXTERNAL(alea_hypercos);
\ No newline at end of file
@@ -1,4 +1,8 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_bounded.h"
 #include <random>
 #include <cmath>
 
@@ -35,9 +39,10 @@ public:
                 interval_b = static_cast<double>(args[1].a_w.w_long);
             }
         }
+        prepare();
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -57,6 +62,7 @@ public:
             else if (inlet == 2) {
                 interval_b = args[0];
             }
+            prepare();
             return {};
         }
     };
@@ -70,6 +76,7 @@ public:
             else if (inlet == 2) {
                 interval_b = static_cast<double>(args[0].a_w.w_long);
             }
+            prepare();
             return {};
         }
     };
@@ -88,35 +95,60 @@ public:
             cout << "  start (a): " << interval_a << endl;
             cout << "  interval (b): " << interval_b << endl;
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
-    void generate_random_value() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double random_value = dist(m_generator);
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_interval>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
 
-        double n = interval_a + (interval_b - (random_value * ((2 * interval_b) + 0)));
+    void generate_random_value() {
+        m_generator.begin_sample();
         if (type == 1) {
-            interval_result = custom_round(n);
+            // Native integer path: exactly uniform over the integers from a - b to a + b
+            interval_result = static_cast<double>(alea::bounded(m_generator, m_prepared.low, m_prepared.high + 1LL));
             output.send(static_cast<long>(interval_result));
-        } else {
-            interval_result = n;
-            output.send(interval_result);
+            return;
         }
+
+        double random_value = m_generator.uniform();
+
+        double n = interval_a + (interval_b - (random_value * m_prepared.width));
+        interval_result = n;
+        output.send(interval_result);
+    }
+
+    // The bounds as the two paths use them, redone when a or b changes rather than per value.
+    void prepare() {
+        m_prepared.width = 2 * interval_b;
+        m_prepared.low = custom_round(interval_a - std::fabs(interval_b));
+        m_prepared.high = custom_round(interval_a + std::fabs(interval_b));
     }
 
     long custom_round(double value) {
         return static_cast<long>(value > 0.0 ? value + 0.5 : value - 0.5);
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     double interval_a {60};
     double interval_b {2};
     double interval_result {0.0};
-    unsigned long seed_value {std::random_device{}()};
+    struct prepared {
+        double width {4};  // 2b
+        long low {58};     // rounded a - |b| and a + |b| of the integer path
+        long high {62};
+    } m_prepared;
+    unsigned long seed_value {0};
     int type {0};
+
+public:
+    alea::engine_messages<alea_interval> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_interval);
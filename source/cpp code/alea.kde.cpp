@@ -0,0 +1,213 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_kde.h"
+#include <vector>
+
+using namespace c74::min;
+
+class alea_kde : public object<alea_kde> {
+public:
+    MIN_DESCRIPTION {"Learns a continuous distribution from incoming values and generates new values like them (smoothed bootstrap)"};
+    MIN_TAGS {"random, distribution, analysis, density, bootstrap"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.ana, alea.custom"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    inlet<> learn_inlet {this, "(float/list) Values to learn"};
+    outlet<> output {this, "(float) Output random value"};
+
+    alea_kde(const atoms& args = {}) {
+        if (args.size() > 0) {
+            m_store.set_capacity(static_cast<size_t>(std::max(1L, static_cast<long>(args[0]))));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            if (m_store.size() == 0) {
+                cerr << "alea_kde: nothing learned yet, send values to the right inlet" << endl;
+                return {};
+            }
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random values at once as a list",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count();
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            if (m_store.size() == 0) {
+                cerr << "alea_kde: nothing learned yet, send values to the right inlet" << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Learn a value",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                m_store.add(m_generator, args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Learn a value",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                m_store.add(m_generator, static_cast<double>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> list {this, "list", "Learn the values of a list, in order",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                for (const auto& value : args) {
+                    m_store.add(m_generator, static_cast<double>(value));
+                }
+            }
+            return {};
+        }
+    };
+
+    message<> clear {this, "clear", "Forget the values learned",
+        MIN_FUNCTION {
+            m_store.clear();
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_kde state:" << endl;
+            cout << "  values kept: " << m_store.size() << " of " << m_store.capacity() << ", " << m_store.seen() << " learned" << endl;
+            cout << "  mean: " << m_store.mean() << ", sd: " << m_store.sd() << endl;
+            cout << "  bandwidth: " << m_store.bandwidth() << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_kde>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        output.send(m_store(m_generator));
+    }
+
+    void generate_list(long count) {
+        m_batch.resize(static_cast<size_t>(count));
+        for (atom& value : m_batch) {
+            if (m_generator.counter_based()) {
+                // one sample index per value, so that seek and sample_at still address values
+                m_generator.begin_sample();
+            }
+            value = m_store(m_generator);
+        }
+        output.send(m_batch);
+    }
+
+    alea::engine m_generator;
+    alea::kde_reservoir m_store;  // the values kept and their running sums
+    atoms m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_kde> m_engine_messages {this, m_generator, output};
+
+    attribute<int> capacity {this, "capacity", 1000,
+        description {"Most values kept, the memory budget; changing it forgets what was learned"},
+        setter { MIN_FUNCTION {
+            const int n = std::max(1, static_cast<int>(args[0]));
+            if (static_cast<size_t>(n) != m_store.capacity()) {
+                m_store.set_capacity(static_cast<size_t>(n));
+            }
+            return {n};
+        }}
+    };
+
+    attribute<symbol> keep {this, "keep", "recent",
+        description {"recent (default): the last values learned, so the model follows changes; all: a uniform sample of every value since clear (reservoir sampling)"},
+        range {"recent", "all"},
+        setter { MIN_FUNCTION {
+            const symbol name = args[0];
+            if (name == "recent") {
+                m_store.set_recent(true);
+            } else if (name == "all") {
+                m_store.set_recent(false);
+            } else {
+                cerr << "Unknown keep mode " << name << ", use recent or all" << endl;
+                return {symbol("recent")};
+            }
+            return {name};
+        }}
+    };
+
+    attribute<double> bandwidth {this, "bandwidth", 0.0,
+        description {"Standard deviation of the noise added to a learned value; 0 (default) follows the spread of the values (1.06 sd n^-1/5)"},
+        setter { MIN_FUNCTION {
+            const double h = std::max(0.0, static_cast<double>(args[0]));
+            m_store.set_bandwidth(h);
+            return {h};
+        }}
+    };
+
+    attribute<symbol> kernel {this, "kernel", "gauss",
+        description {"Shape of the noise: gauss (default), or epanechnikov, which stays within sqrt(5) bandwidths"},
+        range {"gauss", "epanechnikov"},
+        setter { MIN_FUNCTION {
+            const symbol name = args[0];
+            if (name == "gauss") {
+                m_store.set_kernel(alea::kde_reservoir::kernel::gauss);
+            } else if (name == "epanechnikov") {
+                m_store.set_kernel(alea::kde_reservoir::kernel::epanechnikov);
+            } else {
+                cerr << "Unknown kernel " << name << ", use gauss or epanechnikov" << endl;
+                return {symbol("gauss")};
+            }
+            return {name};
+        }}
+    };
+
+    attribute<int> shrink {this, "shrink", 0,
+        description {"1: pull values towards the mean so that their spread matches the values learned instead of adding the noise to it"},
+        range {0, 1},
+        setter { MIN_FUNCTION {
+            const int on = static_cast<int>(args[0]) != 0;
+            m_store.set_shrink(on);
+            return {on};
+        }}
+    };
+};
+
+MIN_EXTERNAL(alea_kde);
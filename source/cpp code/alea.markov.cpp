@@ -1,4 +1,8 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_dirichlet.h"
 #include <random>
 #include <vector>
 #include <sstream>
@@ -28,7 +32,7 @@ public:
         transition_matrix.resize(num_states, std::vector<double>(num_states, 1.0 / num_states));
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
         current_state = 0; // Default initial state
     }
@@ -91,6 +95,7 @@ public:
             cout << "alea_markov state:" << endl;
             cout << "  current state: " << (current_state + 1) << endl; // Convert to 1-indexed
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             cout << "  transition matrix: " << endl;
             for (const auto& row : transition_matrix) {
                 for (const auto& prob : row) {
@@ -200,13 +205,74 @@ public:
         }
     };
 
+    /**
+     * Message to fill the transition matrix, or one row of it, with random
+     * probabilities drawn from a symmetric Dirichlet distribution.
+     */
+    message<> randomize {this, "randomize", "Fill every row, or the given row, with random probabilities from Dirichlet(alpha): 1 is uniform over all rows, small alpha favors a few transitions, large alpha nearly equal ones",
+        MIN_FUNCTION {
+            if (num_states == 0) {
+                cerr << "Error: Matrix size not set. Use 'size' message first." << endl;
+                return {};
+            }
+            if (args.empty() || static_cast<double>(args[0]) <= 0.0) {
+                cerr << "Error: randomize message expects alpha > 0, optionally followed by a row number." << endl;
+                return {};
+            }
+            int first = 0;
+            int last = num_states - 1;
+            if (args.size() > 1) {
+                const int row = static_cast<int>(args[1]) - 1; // Convert from 1-indexed to 0-indexed
+                if (row < 0 || row >= num_states) {
+                    cerr << "Error: Invalid row number. Must be between 1 and " << num_states << "." << endl;
+                    return {};
+                }
+                first = last = row;
+            }
+            randomize_rows(static_cast<double>(args[0]), first, last);
+            return {};
+        }
+    };
+
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_markov>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_next_state(); }
+
+    // The current state of the chain, kept after the engine words. It must fit
+    // the matrix of this object.
+    void save_words(alea::state_writer& w) const { w.put(static_cast<uint32_t>(current_state)); }
+
+    bool load_words(alea::state_reader& r) {
+        const int state = static_cast<int>(r.get());
+        if (state < 0 || state >= num_states) {
+            return false;
+        }
+        current_state = state;
+        return true;
+    }
+
+    /**
+     * Draw rows first to last of the transition matrix in place, one sample
+     * index per row.
+     */
+    void randomize_rows(double alpha, int first, int last) {
+        m_dirichlet.set(alpha, static_cast<size_t>(num_states));
+        for (int row = first; row <= last; ++row) {
+            m_generator.begin_sample();
+            m_dirichlet(m_generator, transition_matrix[row].data());
+        }
+    }
+
     /**
      * Generate the next state based on the current state and the transition matrix.
      */
     void generate_next_state() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double rand_val = dist(m_generator);
+        m_generator.begin_sample();
+        double rand_val = m_generator.uniform();
         double cumulative_prob = 0.0;
 
         for (int next_state = 0; next_state < num_states; ++next_state) {
@@ -219,11 +285,15 @@ private:
         output.send(current_state + 1); // Convert to 1-indexed before sending
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     int current_state {0}; // Initial state
-    unsigned long seed_value {std::random_device{}()};
+    unsigned long seed_value {0};
     int num_states {0}; // Default to 0, indicating size not set
     std::vector<std::vector<double>> transition_matrix; // Transition probability matrix
+    alea::dirichlet_sampler m_dirichlet; // Row sampler for randomize
+
+public:
+    alea::engine_messages<alea_markov> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_markov);
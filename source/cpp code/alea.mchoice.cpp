@@ -1,5 +1,10 @@
 #include "c74_min.h"
-#include <random>
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_bounded.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using namespace c74::min;
@@ -28,8 +33,10 @@ public:
 
         m_choices.resize(num_choices);
         m_weights.resize(num_choices, 1.0);
+        update_weights();
 
-        m_generator.seed(std::random_device{}());
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
     }
 
     message<> bang {this, "bang", "Generate random choice",
@@ -61,6 +68,7 @@ public:
             }
 
             m_weights = new_weights;
+            update_weights();
             return {};
         }
     };
@@ -123,6 +131,7 @@ public:
                 cout << endl;
             }
             cout << "  Seed: " << seed_value << endl;
+            cout << "  Engine: " << m_generator.name() << endl;
             return {};
         }
     };
@@ -138,7 +147,15 @@ public:
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_multi_choice>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { make_choice(); }
+
     void make_choice() {
+        m_generator.begin_sample();
         bool has_empty_choice = false;
         for (const auto& choice : m_choices) {
             if (choice.empty()) {
@@ -152,11 +169,57 @@ private:
             empty_choice_warning_sent = true;
         }
 
-        std::discrete_distribution<> distribution(m_weights.begin(), m_weights.end());
-        int chosen_index = distribution(m_generator);
+        int chosen_index = choose_index();
         output_choice(m_choices[chosen_index], chosen_index);
     }
 
+    // Prepare the selection when the weights change. Equal weights pick an
+    // index directly, whole-number weights pick a point of their exact total;
+    // both use the unbiased bounded integer. Other weights use a double.
+    void update_weights() {
+        const size_t n = m_weights.size();
+        m_cumulative.resize(n);
+        m_integer_cumulative.resize(n);
+        m_equal_weights = true;
+        m_integer_weights = true;
+        const double first = n ? std::max(m_weights[0], 0.0) : 0.0;
+        double total = 0.0;
+        uint64_t integer_total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const double w = std::max(m_weights[i], 0.0);
+            if (w != first) {
+                m_equal_weights = false;
+            }
+            if (w != std::floor(w) || w > 1e15) {
+                m_integer_weights = false;
+            } else {
+                integer_total += static_cast<uint64_t>(w);
+            }
+            total += w;
+            m_cumulative[i] = total;
+            m_integer_cumulative[i] = integer_total;
+        }
+        if (total <= 0.0) {
+            m_equal_weights = true;  // nothing to weight by
+        }
+    }
+
+    int choose_index() {
+        const size_t n = m_weights.size();
+        if (m_equal_weights) {
+            return static_cast<int>(alea::bounded(m_generator, static_cast<uint64_t>(n)));
+        }
+        size_t index;
+        if (m_integer_weights) {
+            const uint64_t point = alea::bounded(m_generator, m_integer_cumulative.back());
+            index = std::upper_bound(m_integer_cumulative.begin(), m_integer_cumulative.end(), point) - m_integer_cumulative.begin();
+        } else {
+            const double point = m_generator.uniform() * m_cumulative.back();
+            index = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), point) - m_cumulative.begin();
+        }
+        return static_cast<int>(std::min(index, n - 1));
+    }
+
     void output_choice(const atoms& choice, int index) {
         if (choice.empty()) {
             output.send(0);
@@ -167,11 +230,18 @@ private:
         }
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     std::vector<atoms> m_choices;
     std::vector<double> m_weights;
+    std::vector<double> m_cumulative;
+    std::vector<uint64_t> m_integer_cumulative;
+    bool m_equal_weights = true;
+    bool m_integer_weights = true;
     bool empty_choice_warning_sent = false;
-    unsigned long seed_value {std::random_device{}()};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_multi_choice> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_multi_choice);
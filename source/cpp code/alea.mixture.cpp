@@ -0,0 +1,210 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_mixture.h"
+#include <vector>
+
+using namespace c74::min;
+
+class alea_mixture : public object<alea_mixture> {
+public:
+    MIN_DESCRIPTION {"Generates random values from a weighted mixture of gauss, laplace, uniform and von Mises distributions"};
+    MIN_TAGS {"random, distribution, mixture, multimodal"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.gauss, alea.laplace, alea.vonmises, alea.mchoice"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    outlet<> output {this, "(float) Output random value"};
+    outlet<> index_output {this, "(int) Component the value came from, 1 to K"};
+
+    alea_mixture(const atoms& args = {}) {
+        // Components as arguments, each a kind followed by its numbers, as for add:
+        // alea.mixture gauss 0 1 gauss 5 1 0.5
+        for (size_t first = 0; first < args.size();) {
+            size_t end = first + 1;
+            while (end < args.size() && args[end].a_type != c74::max::A_SYM) {
+                ++end;
+            }
+            add_component(atoms(args.begin() + first, args.begin() + end));
+            first = end;
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            if (!m_mixture.ready()) {
+                cerr << "alea_mixture: no component with a positive weight, use add" << endl;
+                return {};
+            }
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random values at once as a list",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count();
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            if (!m_mixture.ready()) {
+                cerr << "alea_mixture: no component with a positive weight, use add" << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> add {this, "add", "Add a component: gauss mean sigma, laplace mean lambda, uniform low high or vonmises mean kappa, then an optional weight (1)",
+        MIN_FUNCTION {
+            add_component(args);
+            return {};
+        }
+    };
+
+    message<> weights {this, "weights", "Set the weights of all components, one per component",
+        MIN_FUNCTION {
+            if (args.size() != m_mixture.size()) {
+                cerr << "alea_mixture: weights needs " << m_mixture.size() << " values, one per component" << endl;
+                return {};
+            }
+            std::vector<double> values(args.size());
+            for (size_t i = 0; i < args.size(); ++i) {
+                values[i] = static_cast<double>(args[i]);
+                if (values[i] < 0.0) {
+                    cerr << "alea_mixture: weights must be >= 0" << endl;
+                    return {};
+                }
+            }
+            m_mixture.set_weights(values);
+            prepare();
+            return {};
+        }
+    };
+
+    message<> clear {this, "clear", "Remove all components",
+        MIN_FUNCTION {
+            m_mixture.clear();
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            static const char* names[] = {"gauss", "laplace", "uniform", "vonmises"};
+            cout << "alea_mixture state:" << endl;
+            cout << "  components: " << m_mixture.size() << endl;
+            size_t i = 0;
+            for (const auto& c : m_mixture.components()) {
+                cout << "  " << ++i << ": " << names[static_cast<int>(c.type)] << " " << c.a << " " << c.b << ", weight " << c.weight << endl;
+            }
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    using kind = alea::mixture_sampler::kind;
+
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_mixture>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void add_component(const atoms& args) {
+        if (args.size() < 3 || args.size() > 4) {
+            cerr << "alea_mixture: add needs a kind, two parameters and an optional weight" << endl;
+            return;
+        }
+        const symbol name = args[0];
+        const double a = args[1];
+        const double b = args[2];
+        const double weight = args.size() > 3 ? static_cast<double>(args[3]) : 1.0;
+        if (weight < 0.0) {
+            cerr << "alea_mixture: weight must be >= 0" << endl;
+            return;
+        }
+        if (name == "gauss") {
+            if (b <= 0.0) {
+                cerr << "alea_mixture: gauss sigma must be > 0" << endl;
+                return;
+            }
+            m_mixture.add(kind::gauss, a, b, weight);
+        } else if (name == "laplace") {
+            if (b <= 0.0) {
+                cerr << "alea_mixture: laplace lambda must be > 0" << endl;
+                return;
+            }
+            m_mixture.add(kind::laplace, a, b, weight);
+        } else if (name == "uniform") {
+            m_mixture.add(kind::uniform, a, b, weight);
+        } else if (name == "vonmises") {
+            if (b < 0.0) {
+                cerr << "alea_mixture: vonmises kappa must be >= 0" << endl;
+                return;
+            }
+            m_mixture.add(kind::vonmises, a, b, weight);
+        } else {
+            cerr << "alea_mixture: unknown kind " << name << ", use gauss, laplace, uniform or vonmises" << endl;
+            return;
+        }
+        prepare();
+    }
+
+    void prepare() {
+        if (!m_mixture.prepare()) {
+            cerr << "alea_mixture: every weight is 0" << endl;
+        }
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        size_t index;
+        last_value = m_mixture(m_generator, index);
+        index_output.send(static_cast<long>(index + 1));
+        output.send(last_value);
+    }
+
+    void generate_list(long count) {
+        m_batch.resize(static_cast<size_t>(count));
+        for (double& value : m_batch) {
+            if (m_generator.counter_based()) {
+                // one sample index per value, so that seek and sample_at still address values
+                m_generator.begin_sample();
+            }
+            value = m_mixture(m_generator);
+        }
+        last_value = m_batch.back();
+        output.send(atoms(m_batch.begin(), m_batch.end()));
+    }
+
+    alea::engine m_generator;
+    alea::mixture_sampler m_mixture;  // components and their alias table, set when they change
+    double last_value {0.0};
+    std::vector<double> m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_mixture> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_mixture);
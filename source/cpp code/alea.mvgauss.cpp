@@ -0,0 +1,205 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_mvnormal.h"
+#include <vector>
+
+using namespace c74::min;
+
+class alea_mvgauss : public object<alea_mvgauss> {
+public:
+    MIN_DESCRIPTION {"Generates vectors of correlated random values from a multivariate Gaussian (normal) distribution"};
+    MIN_TAGS {"random, Gaussian, normal, multivariate"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.gauss"};
+
+    inlet<> input {this, "(bang) Generate random vector"};
+    outlet<> output {this, "(list) Output random vector"};
+
+    alea_mvgauss(const atoms& args = {}) {
+        // dimension 1 if the argument is out of range
+        resize_output();
+        set_dimension(args.size() > 0 ? static_cast<long>(args[0]) : 2);
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random vector",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random vectors at once as one list, vector after vector",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count(m_sampler.dimension());
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> dimension {this, "dimension", "Set the number of values per vector, with zero mean and identity covariance",
+        MIN_FUNCTION {
+            if (!args.empty()) {
+                set_dimension(static_cast<long>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> mean {this, "mean", "Set the mean vector; a new length also resets the covariance to identity",
+        MIN_FUNCTION {
+            set_mean(args);
+            return {};
+        }
+    };
+
+    message<> covariance {this, "covariance", "Set the covariance: d x d values row by row, the d (d + 1) / 2 of the lower triangle, or d variances",
+        MIN_FUNCTION {
+            set_covariance(args);
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_mvgauss state:" << endl;
+            cout << "  dimension: " << m_sampler.dimension() << endl;
+            cout << "  rank of covariance: " << m_sampler.rank() << endl;
+            cout << "  mean:";
+            for (double value : m_sampler.mean()) {
+                cout << " " << value;
+            }
+            cout << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_mvgauss>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    // The factor takes d (d + 1) / 2 doubles, 4 MB at the largest.
+    static constexpr size_t max_dimension = 1024;
+
+    void set_dimension(long value) {
+        if (value < 1 || static_cast<unsigned long>(value) > max_dimension) {
+            cerr << "alea_mvgauss: dimension must be between 1 and " << max_dimension << endl;
+            return;
+        }
+        m_sampler.identity(static_cast<size_t>(value));
+        resize_output();
+    }
+
+    void set_mean(const atoms& args) {
+        if (args.empty()) {
+            cerr << "alea_mvgauss: mean needs at least one value" << endl;
+            return;
+        }
+        if (args.size() > max_dimension) {
+            cerr << "alea_mvgauss: mean has more than " << max_dimension << " values" << endl;
+            return;
+        }
+        std::vector<double> values(args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+            values[i] = static_cast<double>(args[i]);
+        }
+        if (values.size() != m_sampler.dimension()) {
+            m_sampler.identity(values.size());
+            resize_output();
+        }
+        m_sampler.set_mean(values);
+    }
+
+    void set_covariance(const atoms& args) {
+        const size_t d = m_sampler.dimension();
+        std::vector<double> c(d * d, 0.0);
+        if (args.size() == d * d) {
+            for (size_t i = 0; i < d * d; ++i) {
+                c[i] = static_cast<double>(args[i]);
+            }
+        } else if (args.size() == d * (d + 1) / 2) {
+            size_t n = 0;
+            for (size_t i = 0; i < d; ++i) {
+                for (size_t j = 0; j <= i; ++j) {
+                    c[i * d + j] = c[j * d + i] = static_cast<double>(args[n++]);
+                }
+            }
+        } else if (args.size() == d) {
+            for (size_t i = 0; i < d; ++i) {
+                c[i * d + i] = static_cast<double>(args[i]);
+            }
+        } else {
+            cerr << "alea_mvgauss: covariance needs " << d * d << ", " << d * (d + 1) / 2 << " or " << d << " values for dimension " << d << endl;
+            return;
+        }
+        if (!m_sampler.set_covariance(c)) {
+            cerr << "alea_mvgauss: covariance must be symmetric positive semidefinite, keeping the previous one" << endl;
+        }
+    }
+
+    // Buffers sized once per dimension, so that a bang does not allocate.
+    void resize_output() {
+        m_vector.assign(m_sampler.dimension(), 0.0);
+        m_atoms.assign(m_sampler.dimension(), atom(0.0));
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        m_sampler(m_generator, m_vector.data());
+        for (size_t i = 0; i < m_vector.size(); ++i) {
+            m_atoms[i] = m_vector[i];
+        }
+        output.send(m_atoms);
+    }
+
+    void generate_list(long count) {
+        const size_t d = m_sampler.dimension();
+        m_batch.resize(static_cast<size_t>(count) * d);
+        if (m_generator.counter_based()) {
+            // one sample index per vector, so that seek and sample_at still address vectors
+            for (size_t v = 0; v < static_cast<size_t>(count); ++v) {
+                m_generator.begin_sample();
+                m_sampler(m_generator, m_batch.data() + v * d);
+            }
+        } else {
+            m_sampler(m_generator, m_batch.data(), static_cast<size_t>(count));
+        }
+        output.send(atoms(m_batch.begin(), m_batch.end()));
+    }
+
+    alea::engine m_generator;
+    alea::mvnormal m_sampler;  // mean and Cholesky factor, set when they change
+    std::vector<double> m_vector;
+    atoms m_atoms;
+    std::vector<double> m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_mvgauss> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_mvgauss);
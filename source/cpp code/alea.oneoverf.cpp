@@ -1,6 +1,11 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
 #include <array>
+#include <algorithm>
+#include <cmath>
 
 using namespace c74::min;
 
@@ -22,9 +27,8 @@ public:
         } else {
             m_mode = 0; // Default to float output
         }
-        std::random_device rd;
-        uint32_t random_seed = rd();
-        set_seed(random_seed);
+        set_nop(m_nop);
+        set_seed(alea::random_seed());
     }
 
     message<> bang {this, "bang", "Generate and output a random number",
@@ -39,7 +43,7 @@ public:
             if (inlet == 1) {
                 m_start = args[0];
             } else if (inlet == 2) {
-                m_nop = args[0];
+                set_nop(args[0]);
             }
             return {};
         }
@@ -69,13 +73,14 @@ public:
             cout << "Mode: " << m_mode << endl;
             cout << "Last result: " << m_result << endl;
             cout << "Seed: " << m_seed << endl;
+            cout << "Engine: " << m_gen.name() << endl;
             return {};
         }
     };
 
     message<> reset {this, "reset", "Reset to default start and nop values",
         MIN_FUNCTION {
-            m_nop = 32;
+            set_nop(32);
             m_start = 0;
             cout << "Reset to Start: 0, NOP: 32" << endl;
             return {};
@@ -83,36 +88,74 @@ public:
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_oneoverf>;
+
+    void reseed(uint32_t s) { set_seed(s); }
+    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }
+    void sample() { generate_noise(); }
+
+    // The last output, kept after the engine words.
+    void save_words(alea::state_writer& w) const {
+        w.put_double(m_start);
+        w.put_double(m_result);
+    }
+
+    bool load_words(alea::state_reader& r) {
+        m_start = r.get_double();
+        m_result = r.get_double();
+        return true;
+    }
+
     uint32_t m_seed;
     int m_mode = 0;
     double m_start = 0;
     double m_nop = 128;
     double m_result = 0;
-    std::mt19937 m_gen;
+    alea::engine m_gen;
+    struct octave {
+        double k;
+        uint64_t threshold;  // flip when the 32-bit draw is below
+    };
+    std::array<octave, 32> m_octave {};
+    size_t m_octaves = 0;
 
     void set_seed(uint32_t s) {
         m_seed = s;
         m_gen.seed(s);
     }
 
+    // The halving weights k and their flip probabilities only depend on nop, so
+    // they are worked out here. A draw x flips the bit when x / 2^32 < probit,
+    // that is when x < ceil(probit * 2^32), so the loop compares integers.
+    void set_nop(double nop) {
+        m_nop = nop;
+        m_octaves = 0;
+        double k = static_cast<int>(nop / 2);
+        double probit = 1.0 / nop;
+        while (k >= 1 && m_octaves < m_octave.size()) {
+            const double threshold = std::ceil(std::min(probit, 1.0) * 0x1.0p32);
+            m_octave[m_octaves++] = {k, static_cast<uint64_t>(threshold)};
+            k = static_cast<int>(k / 2);
+            probit *= 2.0;
+        }
+    }
+
     void generate_noise() {
-        double n = m_nop;
+        m_gen.begin_sample();
         double last = m_start;
         double neww = 0;
-        double k = static_cast<int>(n / 2);
-        double probit = 1.0 / n;
 
-        while (k >= 1) {
+        for (size_t i = 0; i < m_octaves; ++i) {
+            const double k = m_octave[i].k;
             int temp = static_cast<int>(last / k);
             if (temp == 1) {
                 last -= k;
             }
-            if (std::generate_canonical<double, 32>(m_gen) < probit) {
+            if (m_gen() < m_octave[i].threshold) {
                 temp = 1 - temp;
             }
             neww += temp * k;
-            k = static_cast<int>(k / 2);
-            probit *= 2.0;
         }
 
         m_result = neww;
@@ -122,6 +165,9 @@ private:
             noise_out.send(m_result);
         }
     }
+
+public:
+    alea::engine_messages<alea_oneoverf> m_engine_messages {this, m_gen, noise_out};
 };
 
 MIN_EXTERNAL(alea_oneoverf);
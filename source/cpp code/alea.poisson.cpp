@@ -1 +1 @@
-#include "c74_min.h"#include <random>using namespace c74::min;class alea_poisson : public object<alea_poisson> {public:    MIN_DESCRIPTION {"Generates random values following a Poisson distribution"};    MIN_TAGS {"random, poisson"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> lambda_inlet {this, "(float/int) Set lambda value"};    outlet<> output {this, "(float) Output random value"};    alea_poisson(const atoms& args = {}) {        if (!args.empty() && args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            poisson_lambda = args[0];        } else if (!args.empty() && args[0].a_type == c74::max::e_max_atomtypes::A_LONG) {            poisson_lambda = static_cast<double>(args[0].a_w.w_long);        }        // Initialize with a random seed        seed_value = std::random_device{}();        m_generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> float_msg {this, "float", "Set lambda value",        MIN_FUNCTION {            if (inlet == 1) {                poisson_lambda = args[0];            }            return {};        }    };    message<> int_msg {this, "int", "Set lambda value",        MIN_FUNCTION {            if (inlet == 1) {                poisson_lambda = static_cast<double>(args[0].a_w.w_long);            }            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = static_cast<unsigned long>(args[0]);            m_generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_poisson state:" << endl;            cout << "  lambda: " << poisson_lambda << endl;            cout << "  seed: " << seed_value << endl;            return {};        }    };private:    void generate_random_value() {        double temp, v, n = 0.0;        v = exp(-poisson_lambda);        temp = genrand();        if (temp < v) {            n = 0;        } else {            while (temp >= v) {                n = n + 1;                temp *= genrand();            }        }        if (type == 1) {            poisson_result = static_cast<long>(n + 0.5);            output.send(static_cast<long>(poisson_result));        } else {            poisson_result = n;            output.send(poisson_result);        }    }    double genrand() {        std::uniform_real_distribution<double> dist(0.0, 1.0);        return dist(m_generator);    }    std::mt19937 m_generator;    double poisson_lambda {1.0};    double poisson_result {0.0};    unsigned long seed_value {std::random_device{}()};    int type {0};};MIN_EXTERNAL(alea_poisson);
\ No newline at end of file
+#include "c74_min.h"#include "alea_engine.h"#include "alea_seedgroup.h"#include "alea_engine_messages.h"#include "alea_poisson.h"using namespace c74::min;class alea_poisson : public object<alea_poisson> {public:    MIN_DESCRIPTION {"Generates random values following a Poisson distribution"};    MIN_TAGS {"random, poisson"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> lambda_inlet {this, "(float/int) Set lambda value"};    outlet<> output {this, "(float) Output random value"};    alea_poisson(const atoms& args = {}) {        if (!args.empty() && args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {            set_lambda(args[0]);        } else if (!args.empty() && args[0].a_type == c74::max::e_max_atomtypes::A_LONG) {            set_lambda(static_cast<double>(args[0].a_w.w_long));        }        // Initialize with a random seed        seed_value = alea::random_seed();        m_generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> float_msg {this, "float", "Set lambda value",        MIN_FUNCTION {            if (inlet == 1) {                set_lambda(args[0]);            }            return {};        }    };    message<> int_msg {this, "int", "Set lambda value",        MIN_FUNCTION {            if (inlet == 1) {                set_lambda(static_cast<double>(args[0].a_w.w_long));            }            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = static_cast<unsigned long>(args[0]);            m_generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_poisson state:" << endl;            cout << "  lambda: " << poisson_lambda << endl;            cout << "  seed: " << seed_value << endl;            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;            return {};        }    };private:    // alea::engine_messages hooks    friend class alea::engine_messages<alea_poisson>;    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }    void sample() { generate_random_value(); }    void generate_random_value() {        m_generator.begin_sample();        double n = m_sampler(m_generator);        if (type == 1) {            poisson_result = static_cast<long>(n + 0.5);            output.send(static_cast<long>(poisson_result));        } else {            poisson_result = n;            output.send(poisson_result);        }    }    // Recomputes the sampler constants, exp(-lambda) included, only on a new lambda.    void set_lambda(double lambda) {        poisson_lambda = lambda;        m_sampler.set(poisson_lambda);    }    alea::engine m_generator;    double poisson_lambda {1.0};    alea::poisson_sampler m_sampler {poisson_lambda};    double poisson_result {0.0};    unsigned long seed_value {0};    int type {0};public:    alea::engine_messages<alea_poisson> m_engine_messages {this, m_generator, output};};MIN_EXTERNAL(alea_poisson);
\ No newline at end of file
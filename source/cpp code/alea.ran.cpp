@@ -1,6 +1,9 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
-#include <array>
+#include <string>
 
 using namespace c74::min;
 
@@ -15,15 +18,15 @@ public:
     outlet<> output {this, "(float) random number"};
 
     alea_ran(const atoms& args = {})
-        : m_gen(std::random_device{}()), m_mode(5), m_count(0) {
+        : m_mode(5), m_count(0) {
         if (!args.empty()) {
-            m_mode = std::clamp(static_cast<int>(args[0]), 1, 6);
+            set_mode(static_cast<int>(args[0]));
         }
         if (args.size() > 1) {
             long seed_value = args[1];
             set_seed(static_cast<uint32_t>(seed_value));
         } else {
-            set_seed(static_cast<uint32_t>(std::random_device{}()));
+            set_seed(alea::random_seed());
         }
     }
 
@@ -49,7 +52,7 @@ public:
     message<> mode {this, "mode", "Set the output mode (1-6)",
         MIN_FUNCTION {
             if (!args.empty()) {
-                m_mode = std::clamp(static_cast<int>(args[0]), 1, 6);
+                set_mode(static_cast<int>(args[0]));
             }
             return {};
         }
@@ -60,89 +63,76 @@ public:
             cout << "Mode: " << m_mode << endl;
             cout << "Count: " << m_count << endl;
             cout << "Seed: " << m_seed << endl;
+            cout << "Engine: " << m_gen.name() << endl;
             cout << "Last value: " << m_last_value << endl;
             return {};
         }
     };
 
 private:
-    std::mt19937 m_gen;   // Mersenne Twister generator from <random>
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_ran>;
+
+    void reseed(uint32_t s) { set_seed(s); }
+    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }
+    void sample() { output.send(generate()); }
+
+    // Mode 4 only ever runs on mt19937: other engines are refused there, and
+    // so are their states.
+    bool engine_allowed(const symbol& name) {
+        if (m_mode == 4 && std::string(name.c_str()) != "mt19937") {
+            cerr << "alea.ran: mode 4 is the original MT19937, keeping mt19937" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool load_words(alea::state_reader&) {
+        if (m_mode == 4 && m_gen.type() != alea::engine::kind::mt19937) {
+            cerr << "alea.ran: mode 4 is the original MT19937 and only takes mt19937 states" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    alea::engine m_gen;   // Random engine, std::mt19937 unless @engine says otherwise
     uint32_t m_seed = 0;  // Current seed value
     int m_mode = 5;       // Mode of output (1-6)
     long m_count = 0;     // Count of generated numbers
     double m_last_value = 0;  // Last generated value
 
-    // Constants for the original Mersenne Twister implementation
-    static constexpr int N = 624;
-    static constexpr int M = 397;
-    static constexpr uint32_t MATRIX_A = 0x9908b0dfUL;
-    static constexpr uint32_t UPPER_MASK = 0x80000000UL;
-    static constexpr uint32_t LOWER_MASK = 0x7fffffffUL;
-
-    std::array<uint32_t, N> mt;  // State vector for MT19937
-    int mti = N + 1;             // Index for MT19937
+    // Mode 4 is the original MT19937 sequence whatever the engine was, so it
+    // switches the engine to mt19937, which then keeps a single state for
+    // every mode.
+    void set_mode(int mode) {
+        m_mode = std::clamp(mode, 1, 6);
+        if (m_mode == 4 && m_gen.type() != alea::engine::kind::mt19937) {
+            cout << "alea.ran: mode 4 is the original MT19937, switching from @engine " << m_gen.name() << " to mt19937" << endl;
+            m_gen.select(alea::engine::kind::mt19937);
+        }
+    }
 
-    // Set the seed for both std::mt19937 and the original MT19937 implementation
     void set_seed(uint32_t s) {
         m_seed = s;
         m_gen.seed(s);
         m_count = 0;
-
-        // Seed the original MT19937 implementation
-        mt[0] = s & 0xffffffffUL;
-        for (mti = 1; mti < N; mti++) {
-            mt[mti] = (1812433253UL * (mt[mti-1] ^ (mt[mti-1] >> 30)) + mti);
-            mt[mti] &= 0xffffffffUL;
-        }
     }
 
-    // Generate a random 32-bit integer using the original MT19937 implementation
-    uint32_t genrand_int32_original() {
-        uint32_t y;
-        static const uint32_t mag01[2] = {0x0UL, MATRIX_A};
-
-        if (mti >= N) {  // Generate N words at one time
-            int kk;
-
-            if (mti == N+1)
-                set_seed(5489UL);  // Default seed
-
-            for (kk = 0; kk < N - M; kk++) {
-                y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
-                mt[kk] = mt[kk+M] ^ (y >> 1) ^ mag01[y & 0x1UL];
-            }
-            for (; kk < N - 1; kk++) {
-                y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
-                mt[kk] = mt[kk+(M-N)] ^ (y >> 1) ^ mag01[y & 0x1UL];
-            }
-            y = (mt[N-1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
-            mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1UL];
-
-            mti = 0;
-        }
-
-        y = mt[mti++];
-
-        // Tempering
-        y ^= (y >> 11);
-        y ^= (y << 7) & 0x9d2c5680UL;
-        y ^= (y << 15) & 0xefc60000UL;
-        y ^= (y >> 18);
-
-        return y;
-    }
-
-    // Generate a random floating-point number using the original MT19937 implementation
+    // genrand_real2() of the original MT19937 implementation: a raw 32-bit word
+    // divided by 2^32. set_mode() keeps the engine on mt19937 in mode 4; it
+    // refills its state in SIMD blocks (see alea_mt19937.h) and returns the
+    // same words as genrand_int32().
     double genrand_real2_original() {
-        return static_cast<double>(genrand_int32_original()) * (1.0 / 4294967296.0);  // divided by 2^32
+        return static_cast<double>(m_gen()) * (1.0 / 4294967296.0);  // divided by 2^32
     }
 
     // Generate a random number based on the selected mode
     double generate() {
+        m_gen.begin_sample();
         double result;
         switch (m_mode) {
             case 1: // [0, 1] uniform
-                result = std::uniform_real_distribution<>(0.0, 1.0)(m_gen);
+                result = m_gen.uniform();
                 break;
             case 2: // [0, 1) uniform
                 result = std::uniform_real_distribution<>(0.0, std::nextafter(1.0, 0.0))(m_gen);
@@ -150,13 +140,13 @@ private:
             case 3: // (0, 1) uniform
                 result = std::uniform_real_distribution<>(std::nextafter(0.0, 1.0), std::nextafter(1.0, 0.0))(m_gen);
                 break;
-            case 4: // Original MT19937 implementation
+            case 4: // Original MT19937 genrand_real2, [0, 1) with 32-bit resolution
                 result = genrand_real2_original();
                 break;
-            case 5: // Default: (0, 1) uniform, using std::mt19937
-                result = std::uniform_real_distribution<>(0.0, 1.0)(m_gen);
+            case 5: // Default: (0, 1) uniform, using the engine
+                result = m_gen.uniform();
                 break;
-            case 6: // [0, 1) with 53-bit resolution, using std::mt19937
+            case 6: // [0, 1) with 53-bit resolution, using the engine
                 std::uniform_int_distribution<uint64_t> dist(0, (1ULL << 53) - 1);
                 result = static_cast<double>(dist(m_gen)) / (1ULL << 53);
                 break;
@@ -164,6 +154,9 @@ private:
         m_last_value = result;
         return result;
     }
+
+public:
+    alea::engine_messages<alea_ran> m_engine_messages {this, m_gen, output};
 };
 
 MIN_EXTERNAL(alea_ran);
@@ -1,4 +1,8 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_bounded.h"
 #include <random>
 #include <array>
 
@@ -21,10 +25,11 @@ public:
             m_low1 = static_cast<double>(args[0]);
             m_high2 = static_cast<double>(args[1]);
         }
+        prepare();
         if (args.size() > 2) {
             set_seed(static_cast<uint32_t>(static_cast<int>(args[2])));
         } else {
-            set_seed(static_cast<uint32_t>(std::random_device{}()));
+            set_seed(alea::random_seed());
         }
     }
 
@@ -42,6 +47,7 @@ public:
             } else if (inlet == 2) {
                 m_high2 = args[0];
             }
+            prepare();
             return {};
         }
     };
@@ -53,6 +59,7 @@ public:
             } else if (inlet == 2) {
                 m_high2 = static_cast<double>(args[0]);
             }
+            prepare();
             return {};
         }
     };
@@ -66,7 +73,7 @@ public:
         }
     };
 
-    message<> mode {this, "mode", "Set the output mode (0: float, 1: int)",
+    message<> mode {this, "mode", "Set the output mode (0: float, 1: int, uniform over [C, D))",
         MIN_FUNCTION {
             if (!args.empty()) {
                 m_outtype = (args[0] == 1);
@@ -80,6 +87,7 @@ public:
             cout << "Mode: " << (m_outtype ? "int" : "float") << endl;
             cout << "Count: " << m_count << endl;
             cout << "Seed: " << m_seed << endl;
+            cout << "Engine: " << m_gen.name() << endl;
             cout << "Last value: " << m_last_value << endl;
             cout << "Low limit (C): " << m_low1 << endl;
             cout << "High limit (D): " << m_high2 << endl;
@@ -88,13 +96,25 @@ public:
     };
 
 private:
-    std::mt19937 m_gen;
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_rancd>;
+
+    void reseed(uint32_t s) { set_seed(s); }
+    void restore_seed(uint64_t s) { m_seed = static_cast<uint32_t>(s); }
+    void sample() { generate_random(); }
+
+    alea::engine m_gen;
     uint32_t m_seed;
     long m_count{0};
     double m_last_value{0.0};
     double m_low1{0.0};
     double m_high2{1.0};
     bool m_outtype{false};
+    struct prepared {
+        double span{1.0};     // D - C
+        long long low{0};     // rounded bounds of the integer path
+        long long high{1};
+    } m_prepared;
 
     void set_seed(uint32_t s) {
         if (m_seed != s) {
@@ -104,18 +124,32 @@ private:
         }
     }
 
+    // The bounds as the two paths use them, redone when C or D changes rather than per value.
+    void prepare() {
+        m_prepared.span = m_high2 - m_low1;
+        m_prepared.low = std::llround(std::min(m_low1, m_high2));
+        m_prepared.high = std::llround(std::max(m_low1, m_high2));
+    }
+
     void generate_random() {
+        m_gen.begin_sample();
         m_count++;
-        double rand_val = std::uniform_real_distribution<>(0.0, 1.0)(m_gen);
-        double scaled_value = m_low1 + (rand_val * (m_high2 - m_low1));
-        m_last_value = scaled_value;
-
         if (m_outtype) {
-            output.send(static_cast<int>(std::round(scaled_value)));
-        } else {
-            output.send(scaled_value);
+            // Native integer path: exactly uniform over [C, D) of the rounded bounds
+            long long value = alea::bounded(m_gen, m_prepared.low, m_prepared.high);
+            m_last_value = static_cast<double>(value);
+            output.send(static_cast<int>(value));
+            return;
         }
+
+        double rand_val = m_gen.uniform();
+        double scaled_value = m_low1 + (rand_val * m_prepared.span);
+        m_last_value = scaled_value;
+        output.send(scaled_value);
     }
+
+public:
+    alea::engine_messages<alea_rancd> m_engine_messages {this, m_gen, output};
 };
 
 MIN_EXTERNAL(alea_rancd);
@@ -0,0 +1,75 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+
+using namespace c74::min;
+
+class alea_seed : public object<alea_seed> {
+public:
+    MIN_DESCRIPTION {"Reseeds every alea object of a seed group at once"};
+    MIN_TAGS {"random, seed"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.ran, random"};
+
+    inlet<> input {this, "(int) Seed the group, (bang) seed it with a fresh random seed"};
+    outlet<> output {this, "(int) Seed sent to the group"};
+
+    alea_seed(const atoms& args = {}) {
+        if (!args.empty() && args[0].a_type == c74::max::e_max_atomtypes::A_SYM) {
+            group = args[0];
+        }
+    }
+
+    message<> int_msg {this, "int", "Seed the group",
+        MIN_FUNCTION {
+            seed_group(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> seed {this, "seed", "Seed the group",
+        MIN_FUNCTION {
+            if (!args.empty()) {
+                seed_group(static_cast<long>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> bang {this, "bang", "Seed the group with a fresh random seed and output it",
+        MIN_FUNCTION {
+            seed_group(static_cast<long>(alea::random_seed()));
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Display current state information",
+        MIN_FUNCTION {
+            const std::string name = static_cast<symbol>(group);
+            cout << "alea.seed : group = " << name << endl;
+            cout << "  objects: " << alea::seed_registry::instance().size(name) << " (subgroups included)" << endl;
+            cout << "  last seed: " << m_seed << endl;
+            return {};
+        }
+    };
+
+    attribute<symbol> group {this, "group", "",
+        description {"Name of the seed group, as set with @seedgroup on the alea objects"}
+    };
+
+private:
+    void seed_group(long master) {
+        const std::string name = static_cast<symbol>(group);
+        if (name.empty()) {
+            cerr << "alea.seed: no group, set one with @group or as argument" << endl;
+            return;
+        }
+        m_seed = master;
+        alea::seed_registry::instance().seed(name, static_cast<uint64_t>(master));
+        output.send(master);
+    }
+
+    long m_seed {0};
+};
+
+MIN_EXTERNAL(alea_seed);
@@ -0,0 +1,239 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_list.h"
+#include "alea_sphere.h"
+#include <vector>
+
+using namespace c74::min;
+
+class alea_sphere : public object<alea_sphere> {
+public:
+    MIN_DESCRIPTION {"Generates random 2D or 3D vectors: von Mises-Fisher directions around a mean direction, or uniform points on or in the circle or sphere"};
+    MIN_TAGS {"random, distribution, circle, sphere, direction"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.vonmises, alea.circ"};
+
+    inlet<> input {this, "(bang) Generate random vector"};
+    inlet<> kappa_inlet {this, "(float) Set concentration (kappa) around the direction"};
+    outlet<> output {this, "(list) Output random vector"};
+
+    alea_sphere(const atoms& args = {}) {
+        if (args.size() > 0) {
+            set_kappa(static_cast<double>(args[0]));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random vector",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> generate {this, "generate", "Output N random vectors at once as one list, vector after vector",
+        MIN_FUNCTION {
+            const long limit = alea::max_list_count(static_cast<size_t>(m_dim));
+            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {
+                cerr << "generate needs a count between 1 and " << limit << endl;
+                return {};
+            }
+            generate_list(static_cast<long>(args[0]));
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Set concentration (kappa)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_kappa(args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Set concentration (kappa)",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_kappa(static_cast<double>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> direction {this, "direction", "Set the mean direction of shape vmf: x y, or x y z (z is ignored with @dim 2)",
+        MIN_FUNCTION {
+            if (args.size() < 2) {
+                cerr << "alea_sphere: direction needs x y or x y z" << endl;
+                return {};
+            }
+            const double x = args[0];
+            const double y = args[1];
+            const double z = args.size() > 2 ? static_cast<double>(args[2]) : 0.0;
+            if (x == 0.0 && y == 0.0 && z == 0.0) {
+                cerr << "alea_sphere: direction must not be 0 0 0" << endl;
+                return {};
+            }
+            m_direction[0] = x;
+            m_direction[1] = y;
+            m_direction[2] = z;
+            prepare();
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_sphere state:" << endl;
+            cout << "  shape: " << shape_name() << ", " << m_dim << "D" << endl;
+            cout << "  direction: " << m_direction[0] << " " << m_direction[1];
+            if (m_dim == 3) {
+                cout << " " << m_direction[2];
+            }
+            cout << endl;
+            cout << "  kappa: " << m_kappa << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    enum class shape_kind { vmf, sphere, ball };
+
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_sphere>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void set_kappa(double value) {
+        if (value < 0.0) {
+            cerr << "alea_sphere: kappa must be >= 0" << endl;
+            return;
+        }
+        m_kappa = value;
+        prepare();
+    }
+
+    void prepare() {
+        m_vmf.set(m_dim, m_direction[0], m_direction[1], m_direction[2], m_kappa);
+        m_atoms.assign(static_cast<size_t>(m_dim), atom(0.0));
+    }
+
+    const char* shape_name() const {
+        switch (m_shape) {
+            case shape_kind::sphere: return m_dim == 2 ? "sphere (circle)" : "sphere";
+            case shape_kind::ball: return m_dim == 2 ? "ball (disk)" : "ball";
+            default: return "vmf";
+        }
+    }
+
+    void draw(double* out) {
+        switch (m_shape) {
+            case shape_kind::sphere:
+                if (m_dim == 2) {
+                    alea::uniform_circle(m_generator, out);
+                } else {
+                    alea::uniform_sphere(m_generator, out);
+                }
+                break;
+            case shape_kind::ball:
+                if (m_dim == 2) {
+                    alea::uniform_disk(m_generator, out);
+                } else {
+                    alea::uniform_ball(m_generator, out);
+                }
+                break;
+            default:
+                m_vmf(m_generator, out);
+                break;
+        }
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        double vector[3];
+        draw(vector);
+        for (int i = 0; i < m_dim; ++i) {
+            m_atoms[i] = vector[i];
+        }
+        output.send(m_atoms);
+    }
+
+    void generate_list(long count) {
+        const size_t d = static_cast<size_t>(m_dim);
+        m_batch.resize(static_cast<size_t>(count) * d);
+        if (m_generator.counter_based()) {
+            // one sample index per vector, so that seek and sample_at still address vectors
+            for (size_t v = 0; v < static_cast<size_t>(count); ++v) {
+                m_generator.begin_sample();
+                draw(m_batch.data() + v * d);
+            }
+        } else if (m_shape == shape_kind::vmf) {
+            m_vmf.fill(m_generator, m_batch.data(), static_cast<size_t>(count));
+        } else {
+            for (size_t v = 0; v < static_cast<size_t>(count); ++v) {
+                draw(m_batch.data() + v * d);
+            }
+        }
+        output.send(atoms(m_batch.begin(), m_batch.end()));
+    }
+
+    alea::engine m_generator;
+    shape_kind m_shape {shape_kind::vmf};
+    int m_dim {3};
+    double m_direction[3] {1.0, 0.0, 0.0};
+    double m_kappa {1.0};
+    alea::vmf_sampler m_vmf {m_dim, m_direction[0], m_direction[1], m_direction[2], m_kappa};  // Wood's constants and basis, set when they change
+    atoms m_atoms {0.0, 0.0, 0.0};
+    std::vector<double> m_batch;
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_sphere> m_engine_messages {this, m_generator, output};
+
+    attribute<int> dim {this, "dim", 3,
+        description {"Number of values per vector: 2 (circle and disk) or 3 (sphere and ball)"},
+        range {2, 3},
+        setter { MIN_FUNCTION {
+            m_dim = static_cast<int>(args[0]) == 2 ? 2 : 3;
+            prepare();
+            return {m_dim};
+        }}
+    };
+
+    attribute<symbol> shape {this, "shape", "vmf",
+        description {"vmf (default): von Mises-Fisher directions around the direction, concentrated by kappa; sphere: uniform on the unit circle or sphere; ball: uniform in the unit disk or ball"},
+        range {"vmf", "sphere", "ball"},
+        setter { MIN_FUNCTION {
+            const symbol name = args[0];
+            if (name == "vmf") {
+                m_shape = shape_kind::vmf;
+            } else if (name == "sphere") {
+                m_shape = shape_kind::sphere;
+            } else if (name == "ball") {
+                m_shape = shape_kind::ball;
+            } else {
+                cerr << "Unknown shape " << name << ", keeping " << shape_name() << endl;
+            }
+            return {symbol(m_shape == shape_kind::sphere ? "sphere" : m_shape == shape_kind::ball ? "ball" : "vmf")};
+        }}
+    };
+};
+
+MIN_EXTERNAL(alea_sphere);
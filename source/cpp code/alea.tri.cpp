@@ -1,4 +1,7 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
 
 using namespace c74::min;
@@ -45,7 +48,7 @@ public:
         validate_parameters();
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -103,19 +106,28 @@ public:
             cout << "  maximum (b): " << triang_b << endl;
             cout << "  mode (c): " << triang_c << endl;
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_triang>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
     void generate_random_value() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double u = dist(m_generator);
+        m_generator.begin_sample();
+        double u = m_generator.uniform();
 
-        if (u < (triang_c - triang_a) / (triang_b - triang_a)) {
-            triang_result = triang_a + sqrt(u * (triang_b - triang_a) * (triang_c - triang_a));
+        const prepared& p = m_prepared;
+        if (u < p.split) {
+            triang_result = triang_a + sqrt(u * p.width * p.rise);
         } else {
-            triang_result = triang_b - sqrt((1 - u) * (triang_b - triang_a) * (triang_b - triang_c));
+            triang_result = triang_b - sqrt((1 - u) * p.width * p.fall);
         }
 
         output.send(triang_result);
@@ -126,14 +138,32 @@ private:
             cerr << "Mode value (c) must be between minimum (a) and maximum (b)" << endl;
             triang_c = (triang_a + triang_b) / 2; // Default to midpoint if invalid
         }
+        prepare();
+    }
+
+    // The differences of a, b and c, redone when one of them changes rather than per value.
+    void prepare() {
+        m_prepared.width = triang_b - triang_a;
+        m_prepared.rise = triang_c - triang_a;
+        m_prepared.fall = triang_b - triang_c;
+        m_prepared.split = m_prepared.rise / m_prepared.width;
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
+    struct prepared {
+        double width {1.0};  // b - a
+        double rise {0.5};   // c - a
+        double fall {0.5};   // b - c
+        double split {0.5};  // (c - a) / (b - a), the share of values below c
+    } m_prepared;
     double triang_a {0.0};
     double triang_b {1.0};
     double triang_c {0.5}; // Default mode is the midpoint of a and b
     double triang_result {0.0};
-    unsigned long seed_value {std::random_device{}()};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_triang> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_triang);
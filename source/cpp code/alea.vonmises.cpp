@@ -1 +1 @@
-#include "c74_min.h"#include <random>using namespace c74::min;class alea_vonmises : public object<alea_vonmises> {public:    MIN_DESCRIPTION {"Generates random values from a von Mises distribution"};    MIN_TAGS {"random, distribution"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> mu_inlet {this, "(float) Set mu value"};    inlet<> kappa_inlet {this, "(float) Set kappa value"};    outlet<> output {this, "(float) Output random value"};    alea_vonmises(const atoms& args = {}) {        if (args.size() > 0) {            if (args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {                mu = args[0];            }            else if (args[0].a_type == c74::max::e_max_atomtypes::A_LONG) {                mu = static_cast<double>(args[0].a_w.w_long);            }        }        if (args.size() > 1) {            if (args[1].a_type == c74::max::e_max_atomtypes::A_FLOAT) {                kappa = args[1];            }            else if (args[1].a_type == c74::max::e_max_atomtypes::A_LONG) {                kappa = static_cast<double>(args[1].a_w.w_long);            }        }        // Initialize with a random seed        seed_value = std::random_device{}();        m_generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> float_msg {this, "float", "Set mu or kappa value",        MIN_FUNCTION {            if (inlet == 1) {                mu = args[0];            }            else if (inlet == 2) {                kappa = args[0];            }            return {};        }    };    message<> int_msg {this, "int", "Set mu or kappa value",        MIN_FUNCTION {            if (inlet == 1) {                mu = static_cast<double>(args[0].a_w.w_long);            }            else if (inlet == 2) {                kappa = static_cast<double>(args[0].a_w.w_long);            }            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = static_cast<unsigned long>(args[0]);            m_generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_vonmises state:" << endl;            cout << "  mu: " << mu << endl;            cout << "  kappa: " << kappa << endl;            cout << "  seed: " << seed_value << endl;            return {};        }    };private:    void generate_random_value() {        if (kappa <= 0) {            // If kappa is zero or negative, generate a uniform random angle between 0 and 2*pi            std::uniform_real_distribution<double> dist(0.0, 2.0 * M_PI);            vonmises_result = dist(m_generator);        } else {            // Use the acceptance-rejection method for generating von Mises distributed values            std::uniform_real_distribution<double> dist(0.0, 1.0);            double a = 1.0 + sqrt(1.0 + 4.0 * kappa * kappa);            double b = (a - sqrt(2.0 * a)) / (2.0 * kappa);            double r = (1.0 + b * b) / (2.0 * b);            while (true) {                double u1 = dist(m_generator);                double z = cos(M_PI * u1);                double f = (1.0 + r * z) / (r + z);                double c = kappa * (r - f);                double u2 = dist(m_generator);                if (u2 < c * (2.0 - c) || u2 <= c * exp(1.0 - c)) {                    double u3 = dist(m_generator);                    if (u3 > 0.5) {                        vonmises_result = fmod(mu + acos(f), 2.0 * M_PI);                    } else {                        vonmises_result = fmod(mu - acos(f), 2.0 * M_PI);                    }                    break;                }            }        }        output.send(vonmises_result);    }    std::mt19937 m_generator;    double mu {M_PI};  // Mean direction    double kappa {2.0}; // Concentration parameter    double vonmises_result {0.0};    unsigned long seed_value {std::random_device{}()};};MIN_EXTERNAL(alea_vonmises);
\ No newline at end of file
+#include "c74_min.h"#include "alea_engine.h"#include "alea_seedgroup.h"#include "alea_engine_messages.h"#include "alea_list.h"#include "alea_vonmises.h"#include <vector>using namespace c74::min;class alea_vonmises : public object<alea_vonmises> {public:    MIN_DESCRIPTION {"Generates random values from a von Mises distribution"};    MIN_TAGS {"random, distribution"};    MIN_AUTHOR {"Carl Faia"};    MIN_RELATED {"random"};    inlet<> input {this, "(bang) Generate random value"};    inlet<> mu_inlet {this, "(float) Set mu value"};    inlet<> kappa_inlet {this, "(float) Set kappa value"};    outlet<> output {this, "(float) Output random value"};    alea_vonmises(const atoms& args = {}) {        if (args.size() > 0) {            if (args[0].a_type == c74::max::e_max_atomtypes::A_FLOAT) {                mu = args[0];            }            else if (args[0].a_type == c74::max::e_max_atomtypes::A_LONG) {                mu = static_cast<double>(args[0].a_w.w_long);            }        }        if (args.size() > 1) {            if (args[1].a_type == c74::max::e_max_atomtypes::A_FLOAT) {                kappa = args[1];            }            else if (args[1].a_type == c74::max::e_max_atomtypes::A_LONG) {                kappa = static_cast<double>(args[1].a_w.w_long);            }        }        m_sampler.set(mu, kappa);        // Initialize with a random seed        seed_value = alea::random_seed();        m_generator.seed(seed_value);    }    message<> bang {this, "bang", "Generate random value",        MIN_FUNCTION {            generate_random_value();            return {};        }    };    message<> generate {this, "generate", "Output N random values at once as a list",        MIN_FUNCTION {            const long limit = alea::max_list_count();            if (args.empty() || static_cast<long>(args[0]) < 1 || static_cast<long>(args[0]) > limit) {                cerr << "generate needs a count between 1 and " << limit << endl;                return {};            }            generate_list(static_cast<long>(args[0]));            return {};        }    };    message<> float_msg {this, "float", "Set mu or kappa value",        MIN_FUNCTION {            if (inlet == 1) {                mu = args[0];            }            else if (inlet == 2) {                kappa = args[0];            }            m_sampler.set(mu, kappa);            return {};        }    };    message<> int_msg {this, "int", "Set mu or kappa value",        MIN_FUNCTION {            if (inlet == 1) {                mu = static_cast<double>(args[0].a_w.w_long);            }            else if (inlet == 2) {                kappa = static_cast<double>(args[0].a_w.w_long);            }            m_sampler.set(mu, kappa);            return {};        }    };    message<> seed_msg {this, "seed", "Set seed value",        MIN_FUNCTION {            seed_value = static_cast<unsigned long>(args[0]);            m_generator.seed(seed_value);            return {};        }    };    message<> info {this, "info", "Output current state",        MIN_FUNCTION {            cout << "alea_vonmises state:" << endl;            cout << "  mu: " << mu << endl;            cout << "  kappa: " << kappa << endl;            cout << "  seed: " << seed_value << endl;            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;            cout << "  table fallbacks: " << m_sampler.fallbacks() << endl;            return {};        }    };private:    // alea::engine_messages hooks    friend class alea::engine_messages<alea_vonmises>;    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }    void sample() { generate_random_value(); }    void generate_random_value() {        m_generator.begin_sample();        vonmises_result = m_sampler(m_generator);        output.send(vonmises_result);    }    void generate_list(long count) {        m_batch.resize(static_cast<size_t>(count));        if (m_generator.counter_based()) {            // one sample index per value, so that seek and sample_at still address values            for (double& value : m_batch) {                m_generator.begin_sample();                value = m_sampler(m_generator);            }        } else {            m_sampler.fill(m_generator, m_batch.data(), m_batch.size());        }        vonmises_result = m_batch.back();        output.send(atoms(m_batch.begin(), m_batch.end()));    }    alea::engine m_generator;    double mu {M_PI};  // Mean direction    double kappa {2.0}; // Concentration parameter    double vonmises_result {0.0};    alea::vonmises_sampler m_sampler;  // constants for mu and kappa, set when they change    std::vector<double> m_batch;    unsigned long seed_value {0};public:    alea::engine_messages<alea_vonmises> m_engine_messages {this, m_generator, output};    attribute<int> maxtries {this, "maxtries", 0,        description {"Real-time cap on rejection trials per value, 0 for none: a value that reaches it is read from an inverse-CDF table of the current parameters instead, and info reports how often"},        setter { MIN_FUNCTION {            const int n = std::max(0, static_cast<int>(args[0]));            m_sampler.cap(n);            return {n};        }}    };};MIN_EXTERNAL(alea_vonmises);
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
 #include <random>
 
 using namespace c74::min;
@@ -61,7 +64,7 @@ public:
         }
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -131,16 +134,32 @@ public:
             cout << "  high: " << walker_high << endl;
             cout << "  weight: " << walker_weight << endl;
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_walker>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    // The position of the walk, kept after the engine words.
+    void save_words(alea::state_writer& w) const { w.put_double(walker_start); }
+
+    bool load_words(alea::state_reader& r) {
+        walker_start = r.get_double();
+        return true;
+    }
+
     void generate_random_value() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        m_generator.begin_sample();
         
-        double temp = dist(m_generator);
-        double temp2 = dist(m_generator);
+        double temp = m_generator.uniform();
+        double temp2 = m_generator.uniform();
         
         if (temp2 > walker_weight)
             temp = (temp * walker_maxstep) * -1.0;
@@ -159,13 +178,16 @@ private:
         output.send(n);
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
     double walker_start {60.0};
     double walker_maxstep {2.0};
     double walker_low {24.0};
     double walker_high {100.0};
     double walker_weight {0.5};
-    unsigned long seed_value {std::random_device{}()};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_walker> m_engine_messages {this, m_generator, output};
 };
 
 MIN_EXTERNAL(alea_walker);
@@ -1,4 +1,8 @@
 #include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_icdf.h"
 #include <random>
 
 using namespace c74::min;
@@ -32,9 +36,10 @@ public:
                 shape = static_cast<double>(args[1].a_w.w_long);
             }
         }
+        prepare();
 
         // Initialize with a random seed
-        seed_value = std::random_device{}();
+        seed_value = alea::random_seed();
         m_generator.seed(seed_value);
     }
 
@@ -52,6 +57,7 @@ public:
             }
             else if (inlet == 2) {
                 shape = args[0];
+                prepare();
             }
             return {};
         }
@@ -64,6 +70,7 @@ public:
             }
             else if (inlet == 2) {
                 shape = static_cast<double>(args[0].a_w.w_long);
+                prepare();
             }
             return {};
         }
@@ -83,23 +90,66 @@ public:
             cout << "  scale: " << scale << endl;
             cout << "  shape: " << shape << endl;
             cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
             return {};
         }
     };
 
 private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_weibull>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    // Work that only depends on the shape, redone when it changes rather than per value.
+    void prepare() {
+        m_prepared.inv_shape = 1.0 / shape;
+        m_table.reset();
+    }
+
+    // The standard variate of @fast, from the shared table for the current parameters.
+    double table_variate(double u) {
+        if (!m_table) {
+            const double k = shape;
+            m_table = alea::icdf_table::shared("weibull", k, fasterror, [k](double v) { return std::pow(-std::log(1.0 - v), 1.0 / k); });
+        }
+        return (*m_table)(u);
+    }
+
     void generate_random_value() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double U = dist(m_generator);
-        double weibull_result = scale * pow(-log(1.0 - U), 1.0 / shape);
+        m_generator.begin_sample();
+        double U = m_generator.uniform();
+        double weibull_result = fast ? scale * table_variate(U) : scale * pow(-log(1.0 - U), m_prepared.inv_shape);
         output.send(weibull_result);
     }
 
-    std::mt19937 m_generator;
+    alea::engine m_generator;
+    std::shared_ptr<const alea::icdf_table> m_table;  // @fast, built on the next value after a change
+    struct prepared {
+        double inv_shape {1.0 / 3.2};
+    } m_prepared;
     double scale {1.0};  // Scale parameter
     double shape {3.2}; // Shape parameter
     double weibull_result {0.0};
-    unsigned long seed_value {std::random_device{}()};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_weibull> m_engine_messages {this, m_generator, output};
+
+    attribute<bool> fast {this, "fast", false,
+        description {"Sample a table of the inverse CDF instead of calling pow and log on every value: several times faster, within @fasterror"}
+    };
+
+    attribute<double> fasterror {this, "fasterror", 1e-6,
+        description {"Largest error of @fast, relative to the value before the scale (absolute below 1); the table is rebuilt on the next value"},
+        setter { MIN_FUNCTION {
+            double e = args[0];
+            m_table.reset();
+            return {std::max(e, 1e-12)};
+        }}
+    };
 };
 
 MIN_EXTERNAL(alea_weibull);
@@ -0,0 +1,127 @@
+#include "c74_min.h"
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_engine_messages.h"
+#include "alea_zipf.h"
+
+using namespace c74::min;
+
+class alea_zipf : public object<alea_zipf> {
+public:
+    MIN_DESCRIPTION {"Generates random ranks 1 to N from a Zipf distribution, the discrete counterpart of alea.pareto"};
+    MIN_TAGS {"random, distribution, zipf"};
+    MIN_AUTHOR {"Carl Faia"};
+    MIN_RELATED {"alea.pareto, alea.mchoice"};
+
+    inlet<> input {this, "(bang) Generate random value"};
+    inlet<> shape_inlet {this, "(float) Set shape (alpha) value"};
+    inlet<> count_inlet {this, "(int) Set number of ranks (N)"};
+    outlet<> output {this, "(int) Output random rank"};
+
+    alea_zipf(const atoms& args = {}) {
+        if (args.size() > 0) {
+            set_shape(static_cast<double>(args[0]));
+        }
+        if (args.size() > 1) {
+            set_count(static_cast<double>(args[1]));
+        }
+
+        // Initialize with a random seed
+        seed_value = alea::random_seed();
+        m_generator.seed(seed_value);
+    }
+
+    message<> bang {this, "bang", "Generate random value",
+        MIN_FUNCTION {
+            generate_random_value();
+            return {};
+        }
+    };
+
+    message<> float_msg {this, "float", "Set shape or number of ranks",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_shape(args[0]);
+            }
+            else if (inlet == 2) {
+                set_count(args[0]);
+            }
+            return {};
+        }
+    };
+
+    message<> int_msg {this, "int", "Set shape or number of ranks",
+        MIN_FUNCTION {
+            if (inlet == 1) {
+                set_shape(static_cast<double>(args[0]));
+            }
+            else if (inlet == 2) {
+                set_count(static_cast<double>(args[0]));
+            }
+            return {};
+        }
+    };
+
+    message<> seed_msg {this, "seed", "Set seed value",
+        MIN_FUNCTION {
+            seed_value = static_cast<unsigned long>(args[0]);
+            m_generator.seed(seed_value);
+            return {};
+        }
+    };
+
+    message<> info {this, "info", "Output current state",
+        MIN_FUNCTION {
+            cout << "alea_zipf state:" << endl;
+            cout << "  shape (alpha): " << zipf_a << endl;
+            cout << "  ranks (N): " << zipf_n << endl;
+            cout << "  seed: " << seed_value << endl;
+            cout << "  engine: " << m_generator.name() << ", stream " << m_generator.stream_index() << endl;
+            return {};
+        }
+    };
+
+private:
+    // alea::engine_messages hooks
+    friend class alea::engine_messages<alea_zipf>;
+
+    void reseed(uint32_t s) { seed_value = s; m_generator.seed(seed_value); }
+    void restore_seed(uint64_t s) { seed_value = static_cast<unsigned long>(s); }
+    void sample() { generate_random_value(); }
+
+    void set_shape(double value) {
+        if (value < 0.0) {
+            cerr << "alea_zipf: shape must be >= 0" << endl;
+            return;
+        }
+        zipf_a = value;
+        m_sampler.set(zipf_a, zipf_n);
+    }
+
+    void set_count(double value) {
+        if (value < 1.0) {
+            cerr << "alea_zipf: number of ranks must be >= 1" << endl;
+            return;
+        }
+        zipf_n = std::floor(value);
+        m_sampler.set(zipf_a, zipf_n);
+    }
+
+    void generate_random_value() {
+        m_generator.begin_sample();
+        zipf_result = static_cast<long>(m_sampler(m_generator));
+        output.send(zipf_result);
+    }
+
+    alea::engine m_generator;
+    double zipf_a {1.0};
+    double zipf_n {100.0};
+    alea::zipf_sampler m_sampler {zipf_a, zipf_n};  // constants for alpha and N, set when they change
+    long zipf_result {1};
+    unsigned long seed_value {0};
+
+public:
+    alea::engine_messages<alea_zipf> m_engine_messages {this, m_generator, output};
+};
+
+MIN_EXTERNAL(alea_zipf);
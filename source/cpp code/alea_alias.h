@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "alea_bounded.h"
+
+// Weighted choice of an index in constant time, whatever the number of weights
+// (Walker's alias method, built as in Vose, "A linear algorithm for generating
+// random numbers with a given distribution", 1991). set() splits the weights
+// into n columns of equal height, each holding at most two indices: its own,
+// up to m_keep[i], and m_alias[i] above. A choice is one exact bounded integer
+// for the column and one uniform for the side, where a search of the
+// cumulative weights takes time that grows with n.
+//
+// Engine is anything with a 32-bit operator(), next64() and uniform() in
+// [0, 1), like alea::engine.
+
+namespace alea {
+
+    class alias_table {
+    public:
+        // Negative weights count as 0. Returns false, leaving the table empty,
+        // when nothing is left to choose from.
+        bool set(const double* weights, size_t n) {
+            m_keep.assign(n, 0.0);
+            m_alias.assign(n, 0);
+            double total = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                total += weights[i] > 0.0 ? weights[i] : 0.0;
+            }
+            if (!(total > 0.0)) {
+                m_keep.clear();
+                m_alias.clear();
+                return false;
+            }
+
+            // heights scaled so that a full column is 1
+            const double scale = static_cast<double>(n) / total;
+            std::vector<size_t> small;
+            std::vector<size_t> large;
+            for (size_t i = 0; i < n; ++i) {
+                m_keep[i] = (weights[i] > 0.0 ? weights[i] : 0.0) * scale;
+                (m_keep[i] < 1.0 ? small : large).push_back(i);
+            }
+            while (!small.empty() && !large.empty()) {
+                const size_t s = small.back();
+                small.pop_back();
+                const size_t l = large.back();
+                m_alias[s] = static_cast<uint32_t>(l);
+                // l fills the rest of column s
+                m_keep[l] -= 1.0 - m_keep[s];
+                if (m_keep[l] < 1.0) {
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // what is left is full up to rounding
+            for (size_t i : large) {
+                m_keep[i] = 1.0;
+            }
+            for (size_t i : small) {
+                m_keep[i] = 1.0;
+            }
+            return true;
+        }
+
+        bool set(const std::vector<double>& weights) {
+            return set(weights.data(), weights.size());
+        }
+
+        bool empty() const { return m_keep.empty(); }
+        size_t size() const { return m_keep.size(); }
+
+        // Index in [0, size()); the table must not be empty.
+        template<class Engine>
+        size_t operator()(Engine& gen) const {
+            const size_t column = static_cast<size_t>(bounded(gen, static_cast<uint64_t>(m_keep.size())));
+            return gen.uniform() < m_keep[column] ? column : m_alias[column];
+        }
+
+    private:
+        std::vector<double> m_keep;     // share of column i that is i itself
+        std::vector<uint32_t> m_alias;  // the index above it
+    };
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// 64 Bernoulli trials at once, one per bit of a word. Each trial compares a
+// uniform binary fraction, built a bit at a time from successive engine
+// words, with the binary expansion of p, most significant bit first; a lane
+// is decided at the first bit where it differs from p, so the loop ends when
+// all 64 are, after about 8 words, or at the last 1 bit of p (1 word for
+// p = 0.5, 2 for 0.25 or 0.75). p is resolved to 53 bits, as a double holds it.
+//
+// Engine is anything with next64(), like alea::engine.
+
+namespace alea {
+
+    class bernoulli_words {
+    public:
+        explicit bernoulli_words(double p = 0.5) { set(p); }
+
+        void set(double p) {
+            m_all = p >= 1.0;
+            m_bits = p > 0.0 && p < 1.0 ? static_cast<uint64_t>(std::ldexp(p, 53)) : 0;
+            m_last = 0;
+            while (m_last < 53 && m_bits != 0 && ((m_bits >> m_last) & 1u) == 0) {
+                ++m_last;
+            }
+        }
+
+        // Bit i is trial i: 1 with probability p.
+        template<class Engine>
+        uint64_t operator()(Engine& gen) const {
+            if (m_all) {
+                return ~0ULL;
+            }
+            uint64_t result = 0;
+            uint64_t open = ~0ULL;  // lanes still equal to p so far
+            for (int i = 52; i >= m_last && open != 0 && m_bits != 0; --i) {
+                const uint64_t w = gen.next64();
+                const uint64_t p_bit = ((m_bits >> i) & 1u) ? ~0ULL : 0;
+                result |= open & p_bit & ~w;
+                open &= ~(w ^ p_bit);
+            }
+            return result;
+        }
+
+    private:
+        bool m_all {false};
+        uint64_t m_bits {1ULL << 52};  // p * 2^53
+        int m_last {52};               // position of the lowest 1 bit of m_bits
+    };
+
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include "alea_gamma.h"
+#include "alea_poisson.h"
+
+// Counts: binomial, geometric and negative binomial variates in a time that
+// does not grow with n or the mean, with their setup done once per parameter
+// change, in set().
+//
+// Binomial: below n min(p, 1 - p) = 30, inversion from 0 up, fewer than 30
+// steps on average; above, BTPE (Kachitvichyanukul and Schmeiser, "Binomial
+// random variate generation", 1988), a triangle, two parallelograms and two
+// exponential tails around the mode, with the final test done on exact log
+// factorials. Geometric: inversion, with log(1 - p) cached. Negative binomial:
+// Poisson(Gamma(r) (1 - p) / p), the gamma-Poisson mixture.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class binomial_sampler {
+    public:
+        binomial_sampler(long n = 1, double p = 0.5) { set(n, p); }
+
+        // n >= 0, 0 <= p <= 1
+        void set(long n, double p) {
+            m_n = n;
+            m_flip = p > 0.5;
+            m_r = std::min(p, 1.0 - p);
+            m_q = 1.0 - m_r;
+            const double nd = static_cast<double>(n);
+            m_npq = nd * m_r * m_q;
+            m_btpe = nd * m_r >= threshold;
+            if (!m_btpe) {
+                m_s = m_r / m_q;
+                m_a = (nd + 1.0) * m_s;
+                m_q_n = std::pow(m_q, nd);
+                m_bound = std::min(nd, nd * m_r + 10.0 * std::sqrt(m_npq + 1.0));
+                return;
+            }
+            const double fm = nd * m_r + m_r;
+            m_m = std::floor(fm);
+            m_p1 = std::floor(2.195 * std::sqrt(m_npq) - 4.6 * m_q) + 0.5;
+            m_xm = m_m + 0.5;
+            m_xl = m_xm - m_p1;
+            m_xr = m_xm + m_p1;
+            m_c = 0.134 + 20.5 / (15.3 + m_m);
+            double a = (fm - m_xl) / (fm - m_xl * m_r);
+            m_lambda_l = a * (1.0 + 0.5 * a);
+            a = (m_xr - fm) / (m_xr * m_q);
+            m_lambda_r = a * (1.0 + 0.5 * a);
+            m_p2 = m_p1 * (1.0 + 2.0 * m_c);
+            m_p3 = m_p2 + m_c / m_lambda_l;
+            m_p4 = m_p3 + m_c / m_lambda_r;
+            m_log_f_mode = std::lgamma(m_m + 1.0) + std::lgamma(nd - m_m + 1.0);
+            m_log_odds = std::log(m_r / m_q);
+        }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_n <= 0 || m_r <= 0.0) {
+                return m_flip ? static_cast<double>(m_n) : 0.0;
+            }
+            const double y = m_btpe ? btpe(gen) : inversion(gen);
+            return m_flip ? static_cast<double>(m_n) - y : y;
+        }
+
+    private:
+        static constexpr double threshold = 30.0;
+
+        template<class Engine>
+        double inversion(Engine& gen) const {
+            for (;;) {
+                double y = 0.0;
+                double f = m_q_n;
+                double u = gen.uniform();
+                while (u >= f) {
+                    u -= f;
+                    y += 1.0;
+                    if (y > m_bound) {
+                        break;
+                    }
+                    f *= m_a / y - m_s;
+                }
+                if (y <= m_bound) {
+                    return y;
+                }
+            }
+        }
+
+        template<class Engine>
+        double btpe(Engine& gen) const {
+            const double nd = static_cast<double>(m_n);
+            for (;;) {
+                const double u = gen.uniform() * m_p4;
+                double v = gen.uniform();
+                double y;
+                if (u <= m_p1) {
+                    // triangle, accepted outright
+                    return std::floor(m_xm - m_p1 * v + u);
+                }
+                if (u <= m_p2) {
+                    // parallelograms
+                    const double x = m_xl + (u - m_p1) / m_c;
+                    v = v * m_c + 1.0 - std::fabs(m_m - x + 0.5) / m_p1;
+                    if (v > 1.0) {
+                        continue;
+                    }
+                    y = std::floor(x);
+                } else if (u <= m_p3) {
+                    // left exponential tail
+                    y = std::floor(m_xl + std::log(v) / m_lambda_l);
+                    if (y < 0.0 || v == 0.0) {
+                        continue;
+                    }
+                    v *= (u - m_p2) * m_lambda_l;
+                } else {
+                    // right exponential tail
+                    y = std::floor(m_xr - std::log(v) / m_lambda_r);
+                    if (y > nd || v == 0.0) {
+                        continue;
+                    }
+                    v *= (u - m_p3) * m_lambda_r;
+                }
+
+                const double k = std::fabs(y - m_m);
+                if (k <= 20.0 || k >= m_npq / 2.0 - 1.0) {
+                    // f(y) / f(mode) by the recurrence, at most 20 steps or close to the mode
+                    const double s = m_r / m_q;
+                    const double a = s * (nd + 1.0);
+                    double f = 1.0;
+                    if (m_m < y) {
+                        for (double i = m_m + 1.0; i <= y; i += 1.0) {
+                            f *= a / i - s;
+                        }
+                    } else if (m_m > y) {
+                        for (double i = y + 1.0; i <= m_m; i += 1.0) {
+                            f /= a / i - s;
+                        }
+                    }
+                    if (v <= f) {
+                        return y;
+                    }
+                    continue;
+                }
+
+                // squeeze on log v, then the exact log f(y) / f(mode)
+                const double rho = (k / m_npq) * ((k * (k / 3.0 + 0.625) + 1.0 / 6.0) / m_npq + 0.5);
+                const double t = -k * k / (2.0 * m_npq);
+                const double log_v = std::log(v);
+                if (log_v < t - rho) {
+                    return y;
+                }
+                if (log_v > t + rho) {
+                    continue;
+                }
+                const double log_f = m_log_f_mode - std::lgamma(y + 1.0) - std::lgamma(nd - y + 1.0) + (y - m_m) * m_log_odds;
+                if (log_v <= log_f) {
+                    return y;
+                }
+            }
+        }
+
+        long m_n {1};
+        bool m_flip {false};  // p > 0.5: draw n - Binomial(n, 1 - p)
+        double m_r {0.5};     // min(p, 1 - p)
+        double m_q {0.5};
+        double m_npq {0.25};
+        bool m_btpe {false};
+        // inversion
+        double m_s {1.0};
+        double m_a {2.0};
+        double m_q_n {0.5};
+        double m_bound {1.0};
+        // BTPE
+        double m_m {0.0};
+        double m_p1 {0.0};
+        double m_xm {0.0};
+        double m_xl {0.0};
+        double m_xr {0.0};
+        double m_c {0.0};
+        double m_lambda_l {0.0};
+        double m_lambda_r {0.0};
+        double m_p2 {0.0};
+        double m_p3 {0.0};
+        double m_p4 {0.0};
+        double m_log_f_mode {0.0};
+        double m_log_odds {0.0};
+    };
+
+    // Failures before the first success.
+    class geometric_sampler {
+    public:
+        explicit geometric_sampler(double p = 0.5) { set(p); }
+
+        // 0 < p <= 1
+        void set(double p) {
+            m_certain = p >= 1.0;
+            m_inv_log_q = m_certain ? 0.0 : 1.0 / std::log1p(-p);
+        }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_certain) {
+                return 0.0;
+            }
+            return std::floor(std::log(open_uniform(gen)) * m_inv_log_q);
+        }
+
+    private:
+        bool m_certain {false};
+        double m_inv_log_q {-1.0 / M_LN2};
+    };
+
+    // Failures before the r-th success; r need not be whole.
+    class negbin_sampler {
+    public:
+        negbin_sampler(double r = 1.0, double p = 0.5) { set(r, p); }
+
+        // r > 0, 0 < p <= 1
+        void set(double r, double p) {
+            m_gamma.set(r);
+            m_scale = (1.0 - p) / p;
+        }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_scale <= 0.0) {
+                return 0.0;
+            }
+            // a Poisson with a new mean every value: its set() is constant work
+            poisson_sampler poisson(m_gamma(gen) * m_scale);
+            return poisson(gen);
+        }
+
+    private:
+        gamma_sampler m_gamma;
+        double m_scale {1.0};  // (1 - p) / p
+    };
+
+}
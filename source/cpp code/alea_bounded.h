@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include "alea_engine.h"
+
+// Exactly uniform integers in a range (Lemire, "Fast random integer generation
+// in an interval", 2019). The draw is multiplied by the range and the high word
+// is the result; the low word tells in one comparison whether the draw fell in
+// the small biased zone, and only then is the one division done and the draw
+// repeated. Scaling a double uniform and rounding instead over-weights some
+// values and halves the end points.
+//
+// Engine is anything with a 32-bit operator() and next64(), like alea::engine.
+
+namespace alea {
+
+    // Uniform in [0, range), range >= 1.
+    template<class Engine>
+    uint64_t bounded(Engine& gen, uint64_t range) {
+        if (range <= 0xffffffffULL) {
+            const uint32_t s = static_cast<uint32_t>(range);
+            uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+            uint32_t low = static_cast<uint32_t>(m);
+            if (low < s) {
+                const uint32_t threshold = static_cast<uint32_t>(-s) % s;
+                while (low < threshold) {
+                    m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+                    low = static_cast<uint32_t>(m);
+                }
+            }
+            return m >> 32;
+        }
+        uint64_t hi;
+        uint64_t low = mul128(gen.next64(), range, hi);
+        if (low < range) {
+            const uint64_t threshold = (0 - range) % range;
+            while (low < threshold) {
+                low = mul128(gen.next64(), range, hi);
+            }
+        }
+        return hi;
+    }
+
+    // Uniform in [lo, hi), or lo if the range is empty.
+    template<class Engine>
+    long long bounded(Engine& gen, long long lo, long long hi) {
+        if (hi <= lo) {
+            return lo;
+        }
+        const uint64_t range = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+        return static_cast<long long>(static_cast<uint64_t>(lo) + bounded(gen, range));
+    }
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "alea_gamma.h"
+
+// Dirichlet(alpha_1, ..., alpha_k) probability vectors, as k independent
+// Gamma(alpha_i) variates divided by their sum, from the Marsaglia-Tsang
+// samplers of alea_gamma.h set up once per alpha, in set(). A symmetric
+// Dirichlet keeps a single sampler for all k components.
+//
+// Below alpha 1 a gamma variate is Gamma(alpha + 1) U^(1 / alpha), which
+// underflows to 0 for small alpha (for alpha = 0.01, U^100 does in one draw
+// out of a thousand or so), and a vector whose parts all underflow has no sum.
+// Such vectors are drawn as logarithms and normalized by their largest part.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class dirichlet_sampler {
+    public:
+        explicit dirichlet_sampler(double alpha = 1.0, size_t k = 2) { set(alpha, k); }
+
+        // Symmetric: alpha > 0 for every one of k >= 1 components.
+        void set(double alpha, size_t k) {
+            m_gammas.assign(1, gamma_sampler(alpha));
+            m_k = k;
+            m_log = alpha < 1.0;
+        }
+
+        // One alpha > 0 per component.
+        void set(const std::vector<double>& alpha) {
+            m_gammas.clear();
+            m_log = false;
+            for (double a : alpha) {
+                m_gammas.emplace_back(a);
+                m_log = m_log || a < 1.0;
+            }
+            m_k = alpha.size();
+        }
+
+        size_t size() const { return m_k; }
+
+        // One vector into out[0 .. k), summing to 1.
+        template<class Engine>
+        void operator()(Engine& gen, double* out) const {
+            const bool symmetric = m_gammas.size() == 1;
+            double sum = 0.0;
+            if (m_log) {
+                double top = -std::numeric_limits<double>::infinity();
+                for (size_t i = 0; i < m_k; ++i) {
+                    out[i] = m_gammas[symmetric ? 0 : i].log_value(gen);
+                    top = std::max(top, out[i]);
+                }
+                for (size_t i = 0; i < m_k; ++i) {
+                    out[i] = std::exp(out[i] - top);
+                    sum += out[i];
+                }
+            } else {
+                for (size_t i = 0; i < m_k; ++i) {
+                    out[i] = m_gammas[symmetric ? 0 : i](gen);
+                    sum += out[i];
+                }
+            }
+            const double inv_sum = 1.0 / sum;
+            for (size_t i = 0; i < m_k; ++i) {
+                out[i] *= inv_sum;
+            }
+        }
+
+    private:
+        std::vector<gamma_sampler> m_gammas;  // one per component, or one for all
+        size_t m_k {2};
+        bool m_log {false};  // some alpha below 1: draw logarithms
+    };
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "alea_alias.h"
+
+// An empirical distribution over n bins of given weights, such as a drawn
+// histogram. set() builds two views of it, once per change of the weights:
+//
+// - an alias table, for a bin in constant time whatever n;
+// - the cumulative weights at the bin edges, normalized to 1, a piecewise-
+//   linear CDF that spreads each bin evenly over its width.
+//
+// A continuous value is a bin from the alias table plus a uniform offset
+// inside it, which has exactly the distribution of the piecewise-linear CDF,
+// still in constant time. quantile() inverts that CDF for a given
+// probability, by a binary search over the edges.
+//
+// Engine is anything with a 32-bit operator(), next64() and uniform() in
+// [0, 1), like alea::engine.
+
+namespace alea {
+
+    class empirical_sampler {
+    public:
+        // Negative weights count as 0. Returns false, leaving the sampler empty,
+        // when nothing is left to choose from.
+        bool set(const double* weights, size_t n) {
+            if (!m_alias.set(weights, n)) {
+                m_cdf.clear();
+                return false;
+            }
+            m_cdf.assign(n + 1, 0.0);
+            for (size_t i = 0; i < n; ++i) {
+                m_cdf[i + 1] = m_cdf[i] + (weights[i] > 0.0 ? weights[i] : 0.0);
+            }
+            const double inv_total = 1.0 / m_cdf[n];
+            for (double& c : m_cdf) {
+                c *= inv_total;
+            }
+            m_cdf[n] = 1.0;
+            return true;
+        }
+
+        bool set(const std::vector<double>& weights) {
+            return set(weights.data(), weights.size());
+        }
+
+        bool empty() const { return m_alias.empty(); }
+        size_t bins() const { return m_alias.size(); }
+
+        // A bin in [0, n).
+        template<class Engine>
+        size_t bin(Engine& gen) const {
+            return m_alias(gen);
+        }
+
+        // A position in [0, n], bin i covering [i, i + 1).
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            return static_cast<double>(m_alias(gen)) + gen.uniform();
+        }
+
+        // The position below which a share p of the weight lies, 0 <= p <= 1.
+        double quantile(double p) const {
+            p = std::min(1.0, std::max(0.0, p));
+            // the bin whose edges hold p; bins of weight 0 have no width in the CDF
+            const size_t n = bins();
+            size_t i = static_cast<size_t>(std::upper_bound(m_cdf.begin(), m_cdf.end(), p) - m_cdf.begin());
+            i = std::min(std::max<size_t>(i, 1), n) - 1;
+            while (i > 0 && m_cdf[i + 1] == m_cdf[i]) {
+                --i;  // p = 1 falls past the last bin of weight
+            }
+            const double width = m_cdf[i + 1] - m_cdf[i];
+            return static_cast<double>(i) + (width > 0.0 ? std::min(1.0, (p - m_cdf[i]) / width) : 0.0);
+        }
+
+    private:
+        alias_table m_alias;
+        std::vector<double> m_cdf;  // n + 1 edges, from 0 to 1
+    };
+
+}
@@ -0,0 +1,730 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "alea_gf2poly.h"
+#include "alea_mt19937.h"
+#include "alea_state.h"
+
+// Random engines shared by the alea.* objects.
+//
+// Every object owns one alea::engine. It defaults to the Mersenne Twister so that
+// seeded patches reproduce exactly as before, and can be switched with the
+// @engine attribute to one of the compact 64-bit generators below, which keep
+// 8 to 32 bytes of state instead of the 2.5 KB of MT19937.
+
+namespace alea {
+
+    inline uint64_t rotl64(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline uint64_t rotr64(uint64_t x, unsigned k) {
+        return (x >> k) | (x << ((64 - k) & 63));
+    }
+
+    // Full 64 x 64 -> 128 bit product, returns the low word and stores the high word.
+    inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+        hi = static_cast<uint64_t>(p >> 64);
+        return static_cast<uint64_t>(p);
+#else
+        uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+        uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+        uint64_t lo_lo = a_lo * b_lo;
+        uint64_t hi_lo = a_hi * b_lo;
+        uint64_t lo_hi = a_lo * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+        hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+        return (cross << 32) | (lo_lo & 0xffffffffULL);
+#endif
+    }
+
+    // SplitMix64 (Steele, Lea & Flood). 8 bytes of state, also used to expand seeds.
+    class splitmix64 {
+    public:
+        splitmix64() = default;
+        explicit splitmix64(uint64_t s) { seed(s); }
+
+        void seed(uint64_t s) { m_state = s; }
+
+        // Skip delta outputs.
+        void advance(uint64_t delta) { m_state += delta * GAMMA; }
+
+        static constexpr size_t state_size = 2;
+        void save(state_writer& w) const { w.put64(m_state); }
+        void load(state_reader& r) { m_state = r.get64(); }
+
+        uint64_t operator()() {
+            uint64_t z = (m_state += GAMMA);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+
+        uint64_t m_state;
+    };
+
+    // xoshiro256++ (Blackman & Vigna). 32 bytes of state.
+    class xoshiro256pp {
+    public:
+        xoshiro256pp() = default;
+
+        void seed(uint64_t s) {
+            splitmix64 sm(s);
+            for (auto& word : m_s) {
+                word = sm();
+            }
+        }
+
+        uint64_t operator()() {
+            const uint64_t result = rotl64(m_s[0] + m_s[3], 23) + m_s[0];
+            const uint64_t t = m_s[1] << 17;
+            m_s[2] ^= m_s[0];
+            m_s[3] ^= m_s[1];
+            m_s[1] ^= m_s[2];
+            m_s[0] ^= m_s[3];
+            m_s[2] ^= t;
+            m_s[3] = rotl64(m_s[3], 45);
+            return result;
+        }
+
+        // Skip J outputs, given q = t^J mod characteristic(). The jump() and
+        // long_jump() constants of the reference code are q for 2^128 and 2^192.
+        void jump(const gf2poly& q) {
+            std::array<uint64_t, 4> sum {};
+            const int terms = q.degree() + 1;
+            for (int i = 0; i < terms; ++i) {
+                if (q.coeff(i)) {
+                    for (int w = 0; w < 4; ++w) {
+                        sum[w] ^= m_s[w];
+                    }
+                }
+                (*this)();
+            }
+            m_s = sum;
+        }
+
+        static constexpr size_t state_size = 8;
+
+        void save(state_writer& w) const {
+            for (uint64_t word : m_s) {
+                w.put64(word);
+            }
+        }
+
+        void load(state_reader& r) {
+            for (auto& word : m_s) {
+                word = r.get64();
+            }
+        }
+
+        // Characteristic polynomial of the linear state update (degree 256).
+        static const gf2poly& characteristic() {
+            static const gf2poly p = [] {
+                xoshiro256pp gen;
+                gen.seed(1);
+                std::vector<uint8_t> bits(2 * 256);
+                for (auto& bit : bits) {
+                    bit = static_cast<uint8_t>(gen.m_s[0] & 1u);
+                    gen();
+                }
+                return gf2poly::minimal_polynomial(bits);
+            }();
+            return p;
+        }
+
+        // The default substream stride, 2^128: q is the jump() constant of the
+        // reference code.
+        static constexpr int jump_log2 = 128;
+
+        static gf2poly default_jump() {
+            static constexpr uint64_t words[4] = {
+                0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+            };
+            return gf2poly(words, 4);
+        }
+
+    private:
+        std::array<uint64_t, 4> m_s;
+    };
+
+    // PCG64, XSL-RR output on a 128-bit LCG (O'Neill). 32 bytes of state.
+    class pcg64 {
+    public:
+        pcg64() = default;
+
+        void seed(uint64_t s) {
+            splitmix64 sm(s);
+            m_inc_hi = sm();
+            m_inc_lo = sm() | 1;  // the increment must be odd
+            m_state_hi = 0;
+            m_state_lo = 0;
+            step();
+            uint64_t add_lo = sm();
+            uint64_t add_hi = sm();
+            m_state_lo += add_lo;
+            m_state_hi += add_hi + (m_state_lo < add_lo);
+            step();
+        }
+
+        uint64_t operator()() {
+            step();
+            return rotr64(m_state_hi ^ m_state_lo, static_cast<unsigned>(m_state_hi >> 58));
+        }
+
+        // Skip delta outputs in O(log delta) (Brown, "Random number generation
+        // with arbitrary strides", 1994): the affine map of delta steps is built
+        // by repeated squaring of the one-step map.
+        void advance(uint64_t delta_hi, uint64_t delta_lo) {
+            uint64_t mult_hi = MULT_HI, mult_lo = MULT_LO;
+            uint64_t plus_hi = m_inc_hi, plus_lo = m_inc_lo;
+            uint64_t acc_mult_hi = 0, acc_mult_lo = 1;
+            uint64_t acc_plus_hi = 0, acc_plus_lo = 0;
+            while (delta_hi | delta_lo) {
+                if (delta_lo & 1u) {
+                    mul(acc_mult_hi, acc_mult_lo, mult_hi, mult_lo);
+                    mul(acc_plus_hi, acc_plus_lo, mult_hi, mult_lo);
+                    add(acc_plus_hi, acc_plus_lo, plus_hi, plus_lo);
+                }
+                // plus = (mult + 1) * plus, mult = mult * mult
+                uint64_t next_hi = mult_hi, next_lo = mult_lo;
+                add(next_hi, next_lo, 0, 1);
+                mul(plus_hi, plus_lo, next_hi, next_lo);
+                next_hi = mult_hi;
+                next_lo = mult_lo;
+                mul(mult_hi, mult_lo, next_hi, next_lo);
+                delta_lo = (delta_lo >> 1) | (delta_hi << 63);
+                delta_hi >>= 1;
+            }
+            mul(m_state_hi, m_state_lo, acc_mult_hi, acc_mult_lo);
+            add(m_state_hi, m_state_lo, acc_plus_hi, acc_plus_lo);
+        }
+
+        static constexpr size_t state_size = 8;
+
+        void save(state_writer& w) const {
+            w.put64(m_state_hi);
+            w.put64(m_state_lo);
+            w.put64(m_inc_hi);
+            w.put64(m_inc_lo);
+        }
+
+        void load(state_reader& r) {
+            m_state_hi = r.get64();
+            m_state_lo = r.get64();
+            m_inc_hi = r.get64();
+            m_inc_lo = r.get64();
+        }
+
+    private:
+        static constexpr uint64_t MULT_HI = 0x2360ed051fc65da4ULL;
+        static constexpr uint64_t MULT_LO = 0x4385df649fccf645ULL;
+
+        // x = x * y and x = x + y, modulo 2^128
+        static void mul(uint64_t& x_hi, uint64_t& x_lo, uint64_t y_hi, uint64_t y_lo) {
+            uint64_t hi;
+            uint64_t lo = mul128(x_lo, y_lo, hi);
+            x_hi = hi + x_hi * y_lo + x_lo * y_hi;
+            x_lo = lo;
+        }
+
+        static void add(uint64_t& x_hi, uint64_t& x_lo, uint64_t y_hi, uint64_t y_lo) {
+            x_lo += y_lo;
+            x_hi += y_hi + (x_lo < y_lo);
+        }
+
+        // state = state * MULT + inc, modulo 2^128
+        void step() {
+            uint64_t hi;
+            uint64_t lo = mul128(m_state_lo, MULT_LO, hi);
+            hi += m_state_hi * MULT_LO + m_state_lo * MULT_HI;
+            m_state_lo = lo + m_inc_lo;
+            m_state_hi = hi + m_inc_hi + (m_state_lo < lo);
+        }
+
+        uint64_t m_state_hi;
+        uint64_t m_state_lo;
+        uint64_t m_inc_hi;
+        uint64_t m_inc_lo;
+    };
+
+    // Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+    // A counter-based generator: every output block is a pure function of the key
+    // (the seed) and a 128-bit counter. The upper half of the counter holds the
+    // sample index and the lower half the block within that sample, so a sample
+    // that needs any number of draws (rejection loops included) still starts at
+    // a known position, and seek() is O(1).
+    class philox4x32 {
+    public:
+        philox4x32() = default;
+
+        void seed(uint64_t s) {
+            m_key[0] = static_cast<uint32_t>(s);
+            m_key[1] = static_cast<uint32_t>(s >> 32);
+            seek(0);
+        }
+
+        // Position the stream at the first draw of sample n.
+        void seek(uint64_t n) {
+            m_sample = n;
+            m_block = 0;
+            m_pos = 4;
+            m_started = false;
+        }
+
+        // Start the next sample. The first sample after seed() or seek() is the
+        // one seek() selected.
+        void begin_sample() {
+            if (m_started) {
+                ++m_sample;
+            }
+            m_started = true;
+            m_block = 0;
+            m_pos = 4;
+        }
+
+        // Index of the sample the next begin_sample() will start.
+        uint64_t next_sample() const { return m_started ? m_sample + 1 : m_sample; }
+
+        uint32_t next32() {
+            if (m_pos >= 4) {
+                refill();
+            }
+            return m_out[m_pos++];
+        }
+
+        uint64_t operator()() {
+            uint64_t hi = next32();
+            return (hi << 32) | next32();
+        }
+
+        static constexpr size_t state_size = 11;
+
+        void save(state_writer& w) const {
+            w.put(m_key[0]);
+            w.put(m_key[1]);
+            for (uint32_t word : m_out) {
+                w.put(word);
+            }
+            w.put64(m_sample);
+            w.put64(m_block);
+            w.put(static_cast<uint32_t>(m_pos) | (m_started ? 0x100u : 0u));
+        }
+
+        // Whether state_size words hold a valid state.
+        static bool check(state_reader r) {
+            for (int i = 0; i < 10; ++i) {
+                r.get();
+            }
+            return (r.get() & 0xffu) <= 4;
+        }
+
+        void load(state_reader& r) {
+            m_key = {r.get(), r.get()};
+            m_out = {r.get(), r.get(), r.get(), r.get()};
+            m_sample = r.get64();
+            m_block = r.get64();
+            const uint32_t flags = r.get();
+            m_pos = static_cast<uint8_t>(flags & 0xffu);
+            m_started = (flags & 0x100u) != 0;
+        }
+
+        // One Philox4x32-10 block for a given key and counter.
+        static std::array<uint32_t, 4> block(std::array<uint32_t, 2> key, std::array<uint32_t, 4> ctr) {
+            for (int round = 0; round < 10; ++round) {
+                uint64_t p0 = static_cast<uint64_t>(0xd2511f53u) * ctr[0];
+                uint64_t p1 = static_cast<uint64_t>(0xcd9e8d57u) * ctr[2];
+                ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+                       static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+                key[0] += 0x9e3779b9u;
+                key[1] += 0xbb67ae85u;
+            }
+            return ctr;
+        }
+
+    private:
+        void refill() {
+            m_out = block(m_key, {static_cast<uint32_t>(m_block), static_cast<uint32_t>(m_block >> 32),
+                                  static_cast<uint32_t>(m_sample), static_cast<uint32_t>(m_sample >> 32)});
+            ++m_block;
+            m_pos = 0;
+        }
+
+        std::array<uint32_t, 2> m_key;
+        std::array<uint32_t, 4> m_out;
+        uint64_t m_sample;
+        uint64_t m_block;
+        uint8_t m_pos;
+        bool m_started;
+    };
+
+    // The engine owned by each object. Satisfies UniformRandomBitGenerator with a
+    // 32-bit range so the <random> distributions draw from the Mersenne Twister
+    // exactly as they did with a plain std::mt19937 member (alea::mt19937 is
+    // bit-identical to it).
+    class engine {
+    public:
+        using result_type = uint32_t;
+
+        enum class kind : uint8_t { mt19937, xoshiro256pp, pcg64, splitmix64, philox };
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        engine()
+            : m_mt(std::make_unique<alea::mt19937>()) {}
+
+        explicit engine(uint64_t s)
+            : engine() {
+            seed(s);
+        }
+
+        void seed(uint64_t s) {
+            m_seed = s;
+            switch (m_kind) {
+                case kind::mt19937:      m_mt->seed(static_cast<uint32_t>(s)); break;
+                case kind::xoshiro256pp: m_xoshiro.seed(s); break;
+                case kind::pcg64:        m_pcg.seed(s); break;
+                case kind::splitmix64:   m_splitmix.seed(s); break;
+                case kind::philox:       m_philox.seed(s); break;
+            }
+            m_origin = 0;
+            m_jump_pending = false;
+            if (m_stream != 0) {
+                skip_to_stream();
+            }
+        }
+
+        // Put the engine on substream k of its seed: the stream restarts from the
+        // seed and skips k * 2^log2_stride draws (samples for philox), so that
+        // instances sharing one seed with different k cannot overlap before that
+        // many draws. A stride of 0 picks the engine's default: 2^128 for
+        // mt19937 and xoshiro256++, 2^64 for pcg64, 2^32 for splitmix64 and
+        // philox. Returns false, leaving the engine as it was, if k * 2^stride
+        // does not fit in the engine's period. Like the engine choice, the
+        // substream survives later seeds.
+        //
+        // The jump polynomial of mt19937 and xoshiro256++ is built here, once
+        // per substream, and the jump itself waits for the first draw after a
+        // seed, so that seed() stays O(1) on every engine and a group reseed
+        // only costs the instances that then draw.
+        bool stream(long long k, int log2_stride = 0) {
+            const int stride = log2_stride > 0 ? log2_stride : default_stride(m_kind);
+            if (k < 0 || !fits(m_kind, static_cast<uint64_t>(k), stride)) {
+                return false;
+            }
+            m_stream = static_cast<uint64_t>(k);
+            m_stride = log2_stride > 0 ? log2_stride : 0;
+            prepare_stream();
+            seed(m_seed);
+            return true;
+        }
+
+        uint64_t seed() const { return m_seed; }
+        uint64_t stream_index() const { return m_stream; }
+
+        // The complete engine state as words: a tag with the engine kind, the
+        // seed and substream, then the generator itself (626 words for mt19937,
+        // 2 to 11 for the others). A substream jump still to be made is a flag
+        // on the stride word, and the generator is saved as seeded.
+        void save(state_writer& w) const {
+            w.put(STATE_TAG | static_cast<uint32_t>(m_kind));
+            w.put64(m_seed);
+            w.put64(m_stream);
+            w.put(static_cast<uint32_t>(m_stride) | (m_jump_pending ? JUMP_PENDING : 0u));
+            w.put64(m_origin);
+            switch (m_kind) {
+                case kind::mt19937:      m_mt->save(w); break;
+                case kind::xoshiro256pp: m_xoshiro.save(w); break;
+                case kind::pcg64:        m_pcg.save(w); break;
+                case kind::splitmix64:   m_splitmix.save(w); break;
+                case kind::philox:       m_philox.save(w); break;
+            }
+        }
+
+        // Restore a state written by save() that is followed by exactly
+        // `trailing` words of the object's own. Anything else leaves the engine
+        // untouched and returns false. Switches engine if the state needs it.
+        bool load(state_reader& r, size_t trailing = 0) {
+            if (r.remaining() < HEADER_SIZE + trailing || (r.peek() & ~0xffu) != STATE_TAG) {
+                return false;
+            }
+            const uint32_t k = r.peek() & 0xffu;
+            if (k >= kind_count || r.remaining() != HEADER_SIZE + state_size(static_cast<kind>(k)) + trailing) {
+                return false;
+            }
+            // mt19937 and philox are the only generators with words that can be out of range
+            state_reader body(r);
+            for (size_t i = 0; i < HEADER_SIZE; ++i) {
+                body.get();
+            }
+            if ((static_cast<kind>(k) == kind::mt19937 && !alea::mt19937::check(body))
+                || (static_cast<kind>(k) == kind::philox && !philox4x32::check(body))) {
+                return false;
+            }
+            r.get();
+            const uint64_t s = r.get64();
+            const uint64_t stream = r.get64();
+            const uint32_t stride_word = r.get();
+            const int stride = static_cast<int>(stride_word & ~JUMP_PENDING);
+            const uint64_t origin = r.get64();
+            const bool same_stream = static_cast<kind>(k) == m_kind && stream == m_stream && stride == m_stride;
+
+            m_kind = static_cast<kind>(k);
+            if (m_kind == kind::mt19937) {
+                if (!m_mt) {
+                    m_mt = std::make_unique<alea::mt19937>();
+                }
+            } else {
+                m_mt.reset();
+            }
+            m_seed = s;
+            m_stream = stream;
+            m_stride = stride;
+            m_origin = origin;
+            switch (m_kind) {
+                case kind::mt19937:      m_mt->load(r); break;
+                case kind::xoshiro256pp: m_xoshiro.load(r); break;
+                case kind::pcg64:        m_pcg.load(r); break;
+                case kind::splitmix64:   m_splitmix.load(r); break;
+                case kind::philox:       m_philox.load(r); break;
+            }
+            if (!same_stream) {
+                prepare_stream();
+            }
+            m_jump_pending = (stride_word & JUMP_PENDING) != 0 && m_jump != nullptr;
+            return true;
+        }
+
+        // Switch engine and reseed it with the last seed, so that "seed N" followed
+        // by "engine X" and "engine X" followed by "seed N" give the same stream.
+        void select(kind k) {
+            m_kind = k;
+            if (!fits(k, m_stream, stride())) {
+                m_stream = 0;
+            }
+            if (k == kind::mt19937) {
+                if (!m_mt) {
+                    m_mt = std::make_unique<alea::mt19937>();
+                }
+            } else {
+                m_mt.reset();
+            }
+            prepare_stream();
+            seed(m_seed);
+        }
+
+        // Returns false and keeps the current engine if the name is unknown.
+        bool select(const std::string& name) {
+            for (int i = 0; i < kind_count; ++i) {
+                if (name == names()[i]) {
+                    select(static_cast<kind>(i));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        kind type() const { return m_kind; }
+        const char* name() const { return names()[static_cast<int>(m_kind)]; }
+
+        static constexpr int kind_count = 5;
+        static const std::array<const char*, kind_count>& names() {
+            static const std::array<const char*, kind_count> n {"mt19937", "xoshiro256++", "pcg64", "splitmix64", "philox"};
+            return n;
+        }
+
+        result_type operator()() {
+            if (m_jump_pending) {
+                settle();
+            }
+            if (m_kind == kind::mt19937) {
+                return static_cast<result_type>((*m_mt)());
+            }
+            if (m_kind == kind::philox) {
+                return m_philox.next32();
+            }
+            return static_cast<result_type>(next64() >> 32);
+        }
+
+        uint64_t next64() {
+            if (m_jump_pending) {
+                settle();
+            }
+            switch (m_kind) {
+                case kind::mt19937: {
+                    uint64_t hi = (*m_mt)();
+                    return (hi << 32) | (*m_mt)();
+                }
+                case kind::xoshiro256pp: return m_xoshiro();
+                case kind::pcg64:        return m_pcg();
+                case kind::splitmix64:   return m_splitmix();
+                case kind::philox:       return m_philox();
+            }
+            return 0;
+        }
+
+        // Uniform double in [0, 1) with 53 bits of resolution. For mt19937 this is
+        // bit-identical to std::uniform_real_distribution<>(0.0, 1.0); the 64-bit
+        // engines need a single draw instead of two.
+        double uniform() {
+            if (m_jump_pending) {
+                settle();
+            }
+            if (m_kind == kind::mt19937) {
+                return std::generate_canonical<double, std::numeric_limits<double>::digits>(*m_mt);
+            }
+            return static_cast<double>(next64() >> 11) * 0x1.0p-53;
+        }
+
+        // Sample addressing, only available on the counter-based philox engine.
+        // Objects call begin_sample() once per generated value; seek(n) makes the
+        // next value sample n of the seeded stream.
+        bool counter_based() const { return m_kind == kind::philox; }
+
+        void begin_sample() {
+            if (m_kind == kind::philox) {
+                m_philox.begin_sample();
+            }
+        }
+
+        bool seek(long long n) {
+            if (m_kind != kind::philox || n < 0) {
+                return false;
+            }
+            m_philox.seek(m_origin + static_cast<uint64_t>(n));
+            return true;
+        }
+
+        // Run f as sample n, a pure function of (seed, n), and put the stream back
+        // where it was.
+        template<class F>
+        bool sample_at(long long n, F&& f) {
+            if (m_kind != kind::philox || n < 0) {
+                return false;
+            }
+            uint64_t position = m_philox.next_sample();
+            m_philox.seek(m_origin + static_cast<uint64_t>(n));
+            f();
+            m_philox.seek(position);
+            return true;
+        }
+
+    private:
+        static constexpr uint32_t STATE_TAG = 0xa1ea0100u;  // "alea", format 1, low byte is the kind
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr uint32_t JUMP_PENDING = 0x80000000u;  // on the stride word
+
+        static size_t state_size(kind k) {
+            switch (k) {
+                case kind::mt19937:      return alea::mt19937::state_size;
+                case kind::xoshiro256pp: return xoshiro256pp::state_size;
+                case kind::pcg64:        return pcg64::state_size;
+                case kind::splitmix64:   return splitmix64::state_size;
+                case kind::philox:       return philox4x32::state_size;
+            }
+            return 0;
+        }
+
+        static int default_stride(kind k) {
+            switch (k) {
+                case kind::mt19937:
+                case kind::xoshiro256pp: return 128;
+                case kind::pcg64:        return 64;
+                default:                 return 32;
+            }
+        }
+
+        static int period_bits(kind k) {
+            switch (k) {
+                case kind::mt19937:      return 19937;
+                case kind::xoshiro256pp: return 256;
+                case kind::pcg64:        return 128;
+                default:                 return 64;
+            }
+        }
+
+        // Strides are capped at 2^256: the jump polynomial takes one squaring per bit.
+        static bool fits(kind k, uint64_t index, int stride) {
+            int bits = 0;
+            for (uint64_t i = index; i; i >>= 1) {
+                ++bits;
+            }
+            return stride <= 256 && stride + bits <= period_bits(k);
+        }
+
+        int stride() const { return m_stride > 0 ? m_stride : default_stride(m_kind); }
+
+        // The jump polynomial of the substream, for the F2-linear engines.
+        void prepare_stream() {
+            m_jump = nullptr;
+            m_jump_pending = false;
+            if (m_stream == 0) {
+                return;
+            }
+            if (m_kind == kind::mt19937) {
+                m_jump = jump_polynomial<alea::mt19937>(m_stream, stride());
+            } else if (m_kind == kind::xoshiro256pp) {
+                m_jump = jump_polynomial<xoshiro256pp>(m_stream, stride());
+            }
+        }
+
+        // The pending substream jump, made by the first draw after seed().
+        void settle() {
+            m_jump_pending = false;
+            if (m_kind == kind::mt19937) {
+                m_mt->jump(*m_jump);
+            } else {
+                m_xoshiro.jump(*m_jump);
+            }
+        }
+
+        void skip_to_stream() {
+            const int e = stride();
+            switch (m_kind) {
+                case kind::mt19937:
+                case kind::xoshiro256pp:
+                    m_jump_pending = true;
+                    break;
+                case kind::pcg64:
+                    // k * 2^e < 2^128, checked by fits()
+                    m_pcg.advance(e >= 64 ? m_stream << (e - 64) : (e ? m_stream >> (64 - e) : 0),
+                                  e >= 64 ? 0 : m_stream << e);
+                    break;
+                case kind::splitmix64:
+                    m_splitmix.advance(m_stream << e);
+                    break;
+                case kind::philox:
+                    m_origin = m_stream << e;
+                    m_philox.seek(m_origin);
+                    break;
+            }
+        }
+
+        kind m_kind {kind::mt19937};
+        uint64_t m_seed {5489u};
+        uint64_t m_stream {0};
+        int m_stride {0};
+        uint64_t m_origin {0};  // first sample of the philox substream
+        std::shared_ptr<const gf2poly> m_jump;  // t^(k 2^e) of the substream
+        bool m_jump_pending {false};
+        union {
+            splitmix64 m_splitmix;
+            xoshiro256pp m_xoshiro;
+            pcg64 m_pcg;
+            philox4x32 m_philox;
+        };
+        std::unique_ptr<alea::mt19937> m_mt;
+    };
+
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "c74_min.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "alea_engine.h"
+#include "alea_seedgroup.h"
+#include "alea_snapshot.h"
+#include "alea_state.h"
+
+// The messages and attributes every random object shares: @engine, seek,
+// sample_at, stream, getstate, setstate, @seedgroup and @snapshot.
+//
+// An object declares one engine_messages<T> member after its engine and its
+// outlet, makes engine_messages<T> a friend, and provides
+//
+//   void reseed(uint32_t s)          seed from a seed group: the engine and the object's copy of the seed
+//   void restore_seed(uint64_t s)    the object's copy of the seed, after setstate
+//   void sample()                    draw and output one value, for sample_at
+//
+// An object with state of its own next to the engine (a walk position, a
+// current state) also provides
+//
+//   void save_words(state_writer& w) const    write it after the engine words
+//   bool load_words(state_reader& r)          read it back; false refuses the whole state
+//
+// and one that only runs on some engines, bool engine_allowed(const symbol& name).
+// sample_at puts the object's own state back along with the engine position.
+//
+// It is a member rather than a base so that it goes first when the object is
+// freed: the seed link leaves its group before the engine it reseeds is gone.
+
+namespace alea {
+
+    template<class T>
+    class engine_messages {
+    public:
+        engine_messages(T* owner, alea::engine& generator, c74::min::outlet<>& output)
+            : m_owner(owner)
+            , m_generator(generator)
+            , m_output(output) {}
+
+        engine_messages(const engine_messages&) = delete;
+        engine_messages& operator=(const engine_messages&) = delete;
+
+    private:
+        T* m_owner;
+        alea::engine& m_generator;
+        c74::min::outlet<>& m_output;
+        seed_link m_seed_link {[this](uint32_t s) { m_owner->reseed(s); }};
+
+    public:
+        c74::min::message<> seek {m_owner, "seek", "Jump to sample N of the seeded stream (@engine philox)",
+            MIN_FUNCTION {
+                if (args.empty() || !m_generator.seek(static_cast<long>(args[0]))) {
+                    m_owner->cerr << "seek needs @engine philox and a sample index >= 0" << c74::min::endl;
+                }
+                return {};
+            }
+        };
+
+        c74::min::message<> sample_at {m_owner, "sample_at", "Output sample N of the seeded stream without moving it (@engine philox)",
+            MIN_FUNCTION {
+                // The object's own state (a walk position) moves with the sample: put it back too
+                state_writer own;
+                save_words(*m_owner, own, 0);
+                if (args.empty() || !m_generator.sample_at(static_cast<long>(args[0]), [this] { m_owner->sample(); })) {
+                    m_owner->cerr << "sample_at needs @engine philox and a sample index >= 0" << c74::min::endl;
+                }
+                state_reader r(own.words());
+                load_words(*m_owner, r, 0);
+                return {};
+            }
+        };
+
+        c74::min::message<> stream {m_owner, "stream", "Move to substream K of the seed, K * 2^E draws in (E optional, engine default)",
+            MIN_FUNCTION {
+                if (args.empty() || !m_generator.stream(static_cast<long>(args[0]), args.size() > 1 ? static_cast<int>(args[1]) : 0)) {
+                    m_owner->cerr << "stream needs an index >= 0 and a stride that fits the period of " << m_generator.name() << c74::min::endl;
+                }
+                return {};
+            }
+        };
+
+        c74::min::message<> getstate {m_owner, "getstate", "Output the engine state as a state message, or store it with getstate <dict> [key]",
+            MIN_FUNCTION {
+                if (args.empty()) {
+                    m_output.send(state_message(save_state()));
+                } else if (!state_to_dict(args, save_state())) {
+                    m_owner->cerr << "getstate: no dict named " << args[0] << c74::min::endl;
+                }
+                return {};
+            }
+        };
+
+        c74::min::message<> setstate {m_owner, "setstate", "Restore a state from getstate, given as words or as <dict> [key]",
+            MIN_FUNCTION {
+                if (!load_state(state_words(args))) {
+                    m_owner->cerr << "setstate: not a saved state of this object" << c74::min::endl;
+                }
+                return {};
+            }
+        };
+
+        c74::min::attribute<c74::min::symbol> engine_type {m_owner, "engine", "mt19937",
+            c74::min::description {"Random engine: mt19937 (default), xoshiro256++, pcg64, splitmix64 or philox"},
+            c74::min::range {"mt19937", "xoshiro256++", "pcg64", "splitmix64", "philox"},
+            c74::min::setter { MIN_FUNCTION {
+                const c74::min::symbol name = args[0];
+                if (allowed(*m_owner, name, 0) && !m_generator.select(name.c_str())) {
+                    m_owner->cerr << "Unknown engine " << name << ", keeping " << m_generator.name() << c74::min::endl;
+                }
+                return {m_generator.name()};
+            }},
+            c74::min::getter { MIN_GETTER_FUNCTION {
+                return {m_generator.name()};  // setstate may switch engine
+            }}
+        };
+
+        c74::min::attribute<c74::min::symbol> seedgroup {m_owner, "seedgroup", "",
+            c74::min::description {"alea.seed group that reseeds this object; names nest with dots (drums.kick belongs to drums)"},
+            c74::min::setter { MIN_FUNCTION {
+                const c74::min::symbol name = args[0];
+                m_seed_link.join(name.c_str());
+                return {name};
+            }}
+        };
+
+        c74::min::attribute<c74::min::atoms> snapshot {m_owner, "snapshot", {},
+            c74::min::description {"Engine state for pattr: bind pattr to it to store and recall the exact point of the sequence"},
+            c74::min::getter { MIN_GETTER_FUNCTION {
+                return state_atoms(save_state());
+            }},
+            c74::min::setter { MIN_FUNCTION {
+                if (!args.empty() && !load_state(state_words(args))) {
+                    m_owner->cerr << "snapshot: not a saved state of this object" << c74::min::endl;
+                }
+                return args;
+            }}
+        };
+
+    private:
+        // The engine state followed by the object's own words, as getstate writes it.
+        std::vector<uint32_t> save_state() const {
+            state_writer w;
+            m_generator.save(w);
+            save_words(*m_owner, w, 0);
+            return w.words();
+        }
+
+        // A state the object refuses leaves the current one in place.
+        bool load_state(const std::vector<uint32_t>& words) {
+            state_writer own;
+            save_words(*m_owner, own, 0);
+            const size_t trailing = own.words().size();
+            const std::vector<uint32_t> current = save_state();
+
+            state_reader r(words);
+            if (!m_generator.load(r, trailing)) {
+                return false;
+            }
+            if (!load_words(*m_owner, r, 0)) {
+                state_reader back(current);
+                m_generator.load(back, trailing);
+                return false;
+            }
+            m_owner->restore_seed(m_generator.seed());
+            return true;
+        }
+
+        // The optional hooks, and what an object without them gets.
+        template<class U>
+        static auto save_words(const U& o, state_writer& w, int) -> decltype(o.save_words(w)) {
+            return o.save_words(w);
+        }
+        template<class U>
+        static void save_words(const U&, state_writer&, long) {}
+
+        template<class U>
+        static auto load_words(U& o, state_reader& r, int) -> decltype(o.load_words(r)) {
+            return o.load_words(r);
+        }
+        template<class U>
+        static bool load_words(U&, state_reader&, long) { return true; }
+
+        template<class U>
+        static auto allowed(U& o, const c74::min::symbol& name, int) -> decltype(o.engine_allowed(name)) {
+            return o.engine_allowed(name);
+        }
+        template<class U>
+        static bool allowed(U&, const c74::min::symbol&, long) { return true; }
+    };
+
+}
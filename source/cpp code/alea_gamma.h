@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#include "alea_normal.h"
+#include "alea_icdf.h"
+
+// Gamma and beta variates with their per-parameter setup done once, in set(),
+// rather than on every draw. Objects call set() when a parameter changes.
+//
+// Both are rejection methods, so a value takes an unbounded number of trials.
+// cap(n) bounds it for real-time use: after n trials the value is read from a
+// quantile table of the current parameters instead, and counted in
+// fallbacks(). Under a cap the table is built by set() and cap(), with the
+// rest of the setup, so that a value never allocates or integrates: the cap
+// exists for the moment the loop runs long, which is no time to build it.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    // Uniform in (0, 1), never 0, for the logarithms of the rejection tests.
+    template<class Engine>
+    double open_uniform(Engine& gen) {
+        return (static_cast<double>(gen.next64() >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+    // Gamma(shape, 1) (Marsaglia and Tsang, "A simple method for generating gamma
+    // variables", 2000): a cubed normal accepted by a squeeze, which almost never
+    // needs the logarithm. Shapes below 1 draw Gamma(shape + 1) and scale it by
+    // U^(1 / shape).
+    class gamma_sampler {
+    public:
+        explicit gamma_sampler(double shape = 1.0) { set(shape); }
+
+        // shape > 0
+        void set(double shape) {
+            m_shape = shape;
+            m_boost = shape < 1.0;
+            m_inv_shape = 1.0 / shape;
+            m_d = (m_boost ? shape + 1.0 : shape) - 1.0 / 3.0;
+            m_c = 1.0 / std::sqrt(9.0 * m_d);
+            prepare_fallback();
+        }
+
+        // At most max_tries trials per value, 0 for no limit.
+        void cap(int max_tries) {
+            m_max_tries = std::max(0, max_tries);
+            prepare_fallback();
+            m_fallbacks = 0;
+        }
+
+        // Values read from the table since the last cap().
+        unsigned long fallbacks() const { return m_fallbacks; }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            double x;
+            if (!draw(gen, x)) {
+                x = fallback(gen);
+            }
+            if (m_boost) {
+                x *= std::exp(std::log(open_uniform(gen)) * m_inv_shape);
+            }
+            return x;
+        }
+
+        // The logarithm of a value, which stays finite for shapes so far below 1
+        // that the value itself would underflow to 0.
+        template<class Engine>
+        double log_value(Engine& gen) const {
+            double x;
+            if (!draw(gen, x)) {
+                x = fallback(gen);
+            }
+            double log_x = std::log(x);
+            if (m_boost) {
+                log_x += std::log(open_uniform(gen)) * m_inv_shape;
+            }
+            return log_x;
+        }
+
+    private:
+        // Gamma(shape + 1) when boosted, like draw(), so k >= 1. In t = k log x
+        // the density, t - x in logs, is smooth, and the lower tail, about
+        // e^t / Gamma(k + 1), is as wide for every k; it is cut at 1e-12.
+        void prepare_fallback() {
+            if (m_max_tries == 0) {
+                m_fallback = quantile_table();
+                return;
+            }
+            const double k = m_boost ? m_shape + 1.0 : m_shape;
+            const double lo = std::min(std::log(1e-12) + std::lgamma(k + 1.0), k * (std::log(k) - 1.0));
+            const double hi = k * std::log(k + 10.0 * std::sqrt(k) + 30.0);
+            m_fallback = quantile_table([k](double t) { return t - std::exp(t / k); }, lo, hi,
+                                        [k](double t) { return std::exp(t / k); });
+        }
+
+        template<class Engine>
+        double fallback(Engine& gen) const {
+            ++m_fallbacks;
+            return m_fallback(gen.uniform());
+        }
+
+        // Gamma(shape + 1) when boosted; false when the cap ran out.
+        template<class Engine>
+        bool draw(Engine& gen, double& x) const {
+            for (int tries = 0; m_max_tries == 0 || tries < m_max_tries; ++tries) {
+                const double z = normal(gen);
+                double v = 1.0 + m_c * z;
+                if (v <= 0.0) {
+                    continue;
+                }
+                v = v * v * v;
+                const double u = open_uniform(gen);
+                const double z2 = z * z;
+                if (u < 1.0 - 0.0331 * z2 * z2 || std::log(u) < 0.5 * z2 + m_d * (1.0 - v + std::log(v))) {
+                    x = m_d * v;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        double m_shape {1.0};
+        bool m_boost {false};
+        double m_inv_shape {1.0};
+        double m_d {2.0 / 3.0};
+        double m_c {0.0};
+        int m_max_tries {0};
+        quantile_table m_fallback;  // for the current shape, under a cap
+        mutable unsigned long m_fallbacks {0};
+    };
+
+    // Beta(a, b) from a single pair of uniforms per trial, without two gamma
+    // draws (Cheng, "Generating beta variates with nonintegral shape
+    // parameters", 1978): algorithm BB when both shapes are above 1, BC
+    // otherwise.
+    class beta_sampler {
+    public:
+        explicit beta_sampler(double a = 1.0, double b = 1.0) { set(a, b); }
+
+        // a, b > 0
+        void set(double a, double b) {
+            m_a = a;
+            m_b = b;
+            m_swapped = a > b;
+            m_small = std::min(a, b);
+            m_large = std::max(a, b);
+            m_alpha = m_small + m_large;
+            if (m_small > 1.0) {
+                m_beta = std::sqrt((m_alpha - 2.0) / (2.0 * m_small * m_large - m_alpha));
+                m_gamma = m_small + 1.0 / m_beta;
+            } else {
+                m_beta = 1.0 / m_small;
+                const double delta = 1.0 + m_large - m_small;
+                m_k1 = delta * (0.0138889 + 0.0416667 * m_small) / (m_large * m_beta - 0.777778);
+                m_k2 = 0.25 + (0.5 + 0.25 / delta) * m_small;
+            }
+            prepare_fallback();
+        }
+
+        // At most max_tries trials per value, 0 for no limit.
+        void cap(int max_tries) {
+            m_max_tries = std::max(0, max_tries);
+            prepare_fallback();
+            m_fallbacks = 0;
+        }
+
+        // Values read from the table since the last cap().
+        unsigned long fallbacks() const { return m_fallbacks; }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            double x;
+            if (!(m_small > 1.0 ? draw_bb(gen, x) : draw_bc(gen, x))) {
+                return fallback(gen);
+            }
+            return x;
+        }
+
+    private:
+        static constexpr double log4 = 1.3862944;
+
+        // In y = logit x the density, a y - (a + b) log(1 + e^y) in logs, is
+        // smooth for any shapes; the tails, about e^(a y) and e^(-b y), are cut
+        // at 1e-12.
+        void prepare_fallback() {
+            if (m_max_tries == 0) {
+                m_fallback = quantile_table();
+                return;
+            }
+            const double a = m_a;
+            const double b = m_b;
+            const double log_beta = std::lgamma(a) + std::lgamma(b) - std::lgamma(a + b);
+            const double mode = std::log(a / b);
+            const double lo = std::min((std::log(1e-12) + std::log(a) + log_beta) / a, mode - 1.0);
+            const double hi = std::max(-(std::log(1e-12) + std::log(b) + log_beta) / b, mode + 1.0);
+            m_fallback = quantile_table(
+                [a, b](double y) { return a * y - (a + b) * (y > 0 ? y + std::log1p(std::exp(-y)) : std::log1p(std::exp(y))); },
+                lo, hi, [](double y) { return 1.0 / (1.0 + std::exp(-y)); });
+        }
+
+        template<class Engine>
+        double fallback(Engine& gen) const {
+            ++m_fallbacks;
+            return m_fallback(gen.uniform());
+        }
+
+        // w = scale * exp(beta * log(u1 / (1 - u1))), returning v, kept finite.
+        double w_of(double u1, double scale, double& v) const {
+            v = m_beta * std::log(u1 / (1.0 - u1));
+            const double w = scale * std::exp(v);
+            return std::isinf(w) ? std::numeric_limits<double>::max() : w;
+        }
+
+        template<class Engine>
+        bool draw_bb(Engine& gen, double& x) const {
+            double v, w;
+            for (int tries = 0;; ++tries) {
+                if (m_max_tries > 0 && tries == m_max_tries) {
+                    return false;
+                }
+                const double u1 = open_uniform(gen);
+                const double u2 = open_uniform(gen);
+                w = w_of(u1, m_small, v);
+                const double z = u1 * u1 * u2;
+                const double r = m_gamma * v - log4;
+                const double s = m_small + r - w;
+                if (s + 2.609438 >= 5.0 * z) {
+                    break;
+                }
+                const double t = std::log(z);
+                if (s > t || r + m_alpha * std::log(m_alpha / (m_large + w)) >= t) {
+                    break;
+                }
+            }
+            // w / (large + w) is the variate with the smaller shape
+            x = m_swapped ? m_large / (m_large + w) : w / (m_large + w);
+            return true;
+        }
+
+        template<class Engine>
+        bool draw_bc(Engine& gen, double& x) const {
+            double v, w;
+            for (int tries = 0;; ++tries) {
+                if (m_max_tries > 0 && tries == m_max_tries) {
+                    return false;
+                }
+                const double u1 = open_uniform(gen);
+                const double u2 = open_uniform(gen);
+                double z;
+                if (u1 < 0.5) {
+                    const double y = u1 * u2;
+                    z = u1 * y;
+                    if (0.25 * u2 + z - y >= m_k1) {
+                        continue;
+                    }
+                } else {
+                    z = u1 * u1 * u2;
+                    if (z <= 0.25) {
+                        w = w_of(u1, m_large, v);
+                        break;
+                    }
+                    if (z >= m_k2) {
+                        continue;
+                    }
+                }
+                w = w_of(u1, m_large, v);
+                if (m_alpha * (std::log(m_alpha / (m_small + w)) + v) - log4 >= std::log(z)) {
+                    break;
+                }
+            }
+            // w / (small + w) is the variate with the larger shape
+            x = m_swapped ? w / (m_small + w) : m_small / (m_small + w);
+            return true;
+        }
+
+        double m_a {1.0};
+        double m_b {1.0};
+        bool m_swapped {false};  // a > b
+        double m_small {1.0};
+        double m_large {1.0};
+        double m_alpha {2.0};
+        double m_beta {1.0};
+        double m_gamma {0.0};
+        double m_k1 {0.0};
+        double m_k2 {0.0};
+        int m_max_tries {0};
+        quantile_table m_fallback;  // for the current shapes, under a cap
+        mutable unsigned long m_fallbacks {0};
+    };
+
+}
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Polynomials over GF(2), used to jump F2-linear generators (MT19937,
+// xoshiro256) far ahead without drawing the values in between.
+//
+// For a generator whose state transition F has characteristic polynomial p(t),
+// jumping J steps is F^J = q(F) with q(t) = t^J mod p(t), which has fewer terms
+// than p and is applied to the state with one pass of Horner-like stepping
+// (Haramoto et al., "Efficient jump ahead for F2-linear random number
+// generators", 2008). p and q for the default stride are constants of the
+// generator (MT19937's were found once with Berlekamp-Massey from its own
+// output), the other strides and substreams are built from them and cached.
+
+namespace alea {
+
+    class gf2poly {
+        friend class gf2shifts;
+        friend class gf2modulus;
+
+    public:
+        gf2poly() = default;
+
+        // From count words, the coefficient of t^0 in bit 0 of the first.
+        gf2poly(const uint64_t* words, size_t count)
+            : m_words(words, words + count) {
+            trim();
+        }
+
+        static gf2poly monomial(int n) {
+            gf2poly m;
+            m.set(n);
+            return m;
+        }
+
+        bool coeff(int i) const {
+            size_t w = static_cast<size_t>(i) >> 6;
+            return w < m_words.size() && ((m_words[w] >> (i & 63)) & 1u);
+        }
+
+        void set(int i) {
+            size_t w = static_cast<size_t>(i) >> 6;
+            if (w >= m_words.size()) {
+                m_words.resize(w + 1, 0);
+            }
+            m_words[w] |= uint64_t(1) << (i & 63);
+        }
+
+        // Highest power with a non-zero coefficient, -1 for the zero polynomial.
+        int degree() const {
+            for (size_t w = m_words.size(); w-- > 0;) {
+                if (m_words[w]) {
+                    return static_cast<int>(w * 64) + 63 - count_leading_zeros(m_words[w]);
+                }
+            }
+            return -1;
+        }
+
+        const std::vector<uint64_t>& words() const { return m_words; }
+
+        // this ^= other * t^shift
+        void add_shifted(const gf2poly& other, int shift) {
+            add_shifted(other.m_words.data(), other.m_words.size(), shift);
+        }
+
+        // Minimal polynomial of a binary sequence (Berlekamp-Massey), returned as the
+        // characteristic polynomial t^L + c1 t^(L-1) + ... + cL of the recurrence
+        // s[n] = c1 s[n-1] + ... + cL s[n-L]. Needs at least 2L terms.
+        static gf2poly minimal_polynomial(const std::vector<uint8_t>& s) {
+            const int n_terms = static_cast<int>(s.size());
+
+            // The sequence reversed, so that c1..cL line up with s[n-1]..s[n-L]
+            // as one contiguous run of bits.
+            gf2poly reversed;
+            for (int i = 0; i < n_terms; ++i) {
+                if (s[i]) {
+                    reversed.set(n_terms - 1 - i);
+                }
+            }
+
+            gf2poly c = monomial(0);
+            gf2poly b = monomial(0);
+            int length = 0;
+            int m = -1;
+            for (int n = 0; n < n_terms; ++n) {
+                // discrepancy = s[n] + sum c_i s[n-i]
+                const int origin = n_terms - 1 - n;
+                uint64_t acc = 0;
+                const size_t used = std::min(c.m_words.size(), static_cast<size_t>(length / 64 + 1));
+                for (size_t w = 0; w < used; ++w) {
+                    acc ^= c.m_words[w] & reversed.bits_at(origin + static_cast<int>(w * 64));
+                }
+                if (!parity(acc)) {
+                    continue;
+                }
+                if (2 * length <= n) {
+                    gf2poly t = c;
+                    c.add_shifted(b, n - m);
+                    length = n + 1 - length;
+                    b = std::move(t);
+                    m = n;
+                } else {
+                    c.add_shifted(b, n - m);
+                }
+                c.trim();
+            }
+
+            gf2poly p;
+            for (int i = 0; i <= length; ++i) {
+                if (c.coeff(i)) {
+                    p.set(length - i);
+                }
+            }
+            return p;
+        }
+
+    private:
+        static int count_trailing_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#else
+            int n = 0;
+            for (; !(x & 1u); x >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        static int count_leading_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(x);
+#else
+            int n = 0;
+            for (uint64_t bit = uint64_t(1) << 63; !(x & bit); bit >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        static bool parity(uint64_t x) {
+            x ^= x >> 32;
+            x ^= x >> 16;
+            x ^= x >> 8;
+            x ^= x >> 4;
+            x ^= x >> 2;
+            x ^= x >> 1;
+            return x & 1u;
+        }
+
+        // Interleave the 32 bits of x with zeros.
+        static uint64_t spread(uint32_t x) {
+            uint64_t v = x;
+            v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+            v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+            v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            v = (v | (v << 2)) & 0x3333333333333333ULL;
+            v = (v | (v << 1)) & 0x5555555555555555ULL;
+            return v;
+        }
+
+        // 64 coefficients starting at power i.
+        uint64_t bits_at(int i) const {
+            const size_t w = static_cast<size_t>(i) >> 6;
+            const int s = i & 63;
+            uint64_t lo = w < m_words.size() ? m_words[w] : 0;
+            if (s == 0) {
+                return lo;
+            }
+            uint64_t hi = w + 1 < m_words.size() ? m_words[w + 1] : 0;
+            return (lo >> s) | (hi << (64 - s));
+        }
+
+        void add_shifted(const uint64_t* src, size_t count, int shift) {
+            const size_t offset = static_cast<size_t>(shift) >> 6;
+            const int s = shift & 63;
+            const size_t needed = offset + count + (s ? 1 : 0);
+            if (m_words.size() < needed) {
+                m_words.resize(needed, 0);
+            }
+            uint64_t* dst = m_words.data() + offset;
+            if (s == 0) {
+                for (size_t w = 0; w < count; ++w) {
+                    dst[w] ^= src[w];
+                }
+            } else {
+                uint64_t carry = 0;
+                for (size_t w = 0; w < count; ++w) {
+                    dst[w] ^= (src[w] << s) | carry;
+                    carry = src[w] >> (64 - s);
+                }
+                dst[count] ^= carry;
+            }
+        }
+
+        void trim() {
+            while (!m_words.empty() && m_words.back() == 0) {
+                m_words.pop_back();
+            }
+        }
+
+        std::vector<uint64_t> m_words;
+    };
+
+    // The 64 bit shifts of a polynomial, so that adding a * t^i for any i is a
+    // word-aligned XOR that vectorizes.
+    class gf2shifts {
+    public:
+        explicit gf2shifts(const gf2poly& a)
+            : m_stride(a.m_words.size() + 1)
+            , m_words(64 * m_stride, 0) {
+            for (int s = 0; s < 64; ++s) {
+                uint64_t* dst = m_words.data() + s * m_stride;
+                uint64_t carry = 0;
+                for (size_t w = 0; w < a.m_words.size(); ++w) {
+                    dst[w] = (a.m_words[w] << s) | carry;
+                    carry = s ? a.m_words[w] >> (64 - s) : 0;
+                }
+                dst[m_stride - 1] = carry;
+            }
+        }
+
+        // r ^= a * t^i, r must already hold enough words.
+        void add_to(gf2poly& r, int i) const {
+            const uint64_t* src = m_words.data() + (i & 63) * m_stride;
+            uint64_t* dst = r.m_words.data() + (i >> 6);
+            for (size_t w = 0; w < m_stride; ++w) {
+                dst[w] ^= src[w];
+            }
+        }
+
+        size_t size() const { return m_stride; }
+
+    private:
+        size_t m_stride;
+        std::vector<uint64_t> m_words;
+    };
+
+    // Arithmetic modulo a fixed polynomial p.
+    class gf2modulus {
+    public:
+        explicit gf2modulus(gf2poly p)
+            : m_degree(p.degree())
+            , m_top(top_bits(p))
+            , m_shifts(p)
+            , m_poly(std::move(p)) {}
+
+        const gf2poly& poly() const { return m_poly; }
+
+        gf2poly& reduce(gf2poly& a) const {
+            a.m_words.resize(std::max(a.m_words.size(), m_shifts.size() + 1), 0);
+            for (int w = static_cast<int>(a.m_words.size()) - 1; w >= 0 && w * 64 + 63 >= m_degree; --w) {
+                // Clear the bits of word w at or above the degree of p, top down. Which
+                // multiples of p that takes only depends on the top 64 bits of p, so
+                // they are found first and the long additions run back to back.
+                const uint64_t mask = high_mask(w);
+                uint64_t bits = a.m_words[w] & mask;
+                uint64_t quotient = 0;
+                while (bits) {
+                    const int b = 63 - gf2poly::count_leading_zeros(bits);
+                    quotient |= uint64_t(1) << b;
+                    bits = (bits ^ (m_top >> (63 - b))) & mask;
+                }
+                for (; quotient; quotient &= quotient - 1) {
+                    m_shifts.add_to(a, w * 64 + gf2poly::count_trailing_zeros(quotient) - m_degree);
+                }
+            }
+            a.trim();
+            return a;
+        }
+
+        gf2poly mul(const gf2poly& a, const gf2poly& b) const {
+            gf2poly r;
+            r.m_words.assign(a.m_words.size() + b.m_words.size() + 1, 0);
+            const gf2shifts sb(b);
+            for (size_t w = 0; w < a.m_words.size(); ++w) {
+                for (uint64_t bits = a.m_words[w]; bits; bits &= bits - 1) {
+                    sb.add_to(r, static_cast<int>(w * 64) + gf2poly::count_trailing_zeros(bits));
+                }
+            }
+            return reduce(r);
+        }
+
+        // Squaring over GF(2) only spreads the bits apart.
+        gf2poly sqr(const gf2poly& a) const {
+            gf2poly r;
+            r.m_words.assign(a.m_words.size() * 2, 0);
+            for (size_t w = 0; w < a.m_words.size(); ++w) {
+                r.m_words[2 * w] = gf2poly::spread(static_cast<uint32_t>(a.m_words[w]));
+                r.m_words[2 * w + 1] = gf2poly::spread(static_cast<uint32_t>(a.m_words[w] >> 32));
+            }
+            return reduce(r);
+        }
+
+    private:
+        // Bits of word w at powers >= degree.
+        uint64_t high_mask(int w) const {
+            const int low = m_degree - w * 64;
+            return low <= 0 ? ~uint64_t(0) : ~uint64_t(0) << low;
+        }
+
+        // The 64 coefficients of p ending with the leading one, which is bit 63.
+        static uint64_t top_bits(const gf2poly& p) {
+            uint64_t top = 0;
+            const int d = p.degree();
+            for (int i = 0; i < 64 && i <= d; ++i) {
+                top |= static_cast<uint64_t>(p.coeff(d - i)) << (63 - i);
+            }
+            return top;
+        }
+
+        int m_degree;
+        uint64_t m_top;
+        gf2shifts m_shifts;
+        gf2poly m_poly;
+    };
+
+    // The characteristic polynomial of Linear, which provides a static
+    // characteristic(), as a modulus. Built once per process.
+    template<class Linear>
+    const gf2modulus& characteristic_modulus() {
+        static const gf2modulus p(Linear::characteristic());
+        return p;
+    }
+
+    // t^(2^e) mod the characteristic polynomial of Linear, which also provides
+    // jump_log2 and default_jump(), q for its default stride 2^jump_log2.
+    // Cached per process: the others are squared from the nearest power below,
+    // one squaring per bit (about 2 ms each for MT19937), so the first stride
+    // after the default costs one squaring. e is at most 256 + 63 (see
+    // engine::fits()), which bounds the cache.
+    template<class Linear>
+    const gf2poly& jump_polynomial(int e) {
+        static std::mutex lock;
+        static std::map<int, gf2poly> powers {{Linear::jump_log2, Linear::default_jump()}};
+        const gf2modulus& p = characteristic_modulus<Linear>();
+
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = powers.lower_bound(e);
+        if (found != powers.end() && found->first == e) {
+            return found->second;
+        }
+        gf2poly q = gf2poly::monomial(1);
+        int from = 0;
+        if (found != powers.begin()) {
+            --found;
+            q = found->second;
+            from = found->first;
+        } else {
+            p.reduce(q);
+        }
+        for (; from < e; ++from) {
+            q = p.sqr(q);
+        }
+        return powers.emplace(e, std::move(q)).first->second;
+    }
+
+    // t^(k 2^e) mod the characteristic polynomial of Linear, the product of the
+    // powers for the bits of k, so that skipping k * 2^e outputs is a single
+    // jump; k > 0. The last products are cached for the instances that share a
+    // substream; the cache is dropped once it holds max_cached of them, and the
+    // engines that use a product keep their own reference to it.
+    template<class Linear>
+    std::shared_ptr<const gf2poly> jump_polynomial(uint64_t k, int e) {
+        constexpr size_t max_cached = 64;
+        static std::mutex lock;
+        static std::map<std::pair<uint64_t, int>, std::shared_ptr<const gf2poly>> products;
+        const gf2modulus& p = characteristic_modulus<Linear>();
+
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = products.find({k, e});
+        if (found != products.end()) {
+            return found->second;
+        }
+        gf2poly q;
+        bool first = true;
+        int bit = 0;
+        for (uint64_t rest = k; rest; rest >>= 1, ++bit) {
+            if (rest & 1u) {
+                const gf2poly& power = jump_polynomial<Linear>(e + bit);
+                q = first ? power : p.mul(q, power);
+                first = false;
+            }
+        }
+        if (products.size() >= max_cached) {
+            products.clear();
+        }
+        auto product = std::make_shared<const gf2poly>(std::move(q));
+        products.emplace(std::make_pair(k, e), product);
+        return product;
+    }
+
+}
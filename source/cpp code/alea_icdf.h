@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Tabulated inverse CDFs for the `fast` mode of the transform distributions.
+//
+// The inverse CDF of the standard variate (before location and scale) is cut
+// into N equal cells of u, each with a cubic through four equally spaced
+// points, so sampling is one multiplication, one lookup and three
+// multiply-adds instead of a tan, log or pow. N doubles until the cubic meets
+// the error bound in all but a few cells; those, where the function runs off
+// to infinity near u = 0 or 1, keep calling the exact function, as do u where
+// the table could not reach the bound at the largest size.
+//
+// A table only depends on the function, its shape parameter and the error
+// bound, so instances with the same ones share it.
+//
+// quantile_table is a coarser kind for distributions without a closed-form
+// inverse, the fallback of the capped rejection samplers.
+
+namespace alea {
+
+    class icdf_table {
+    public:
+        using function = std::function<double(double)>;
+
+        // |table(u) - f(u)| <= max_error * max(1, |f(u)|) wherever the table is used
+        icdf_table(function f, double max_error)
+            : m_exact(std::move(f)) {
+            for (m_cells = initial_cells;; m_cells *= 2) {
+                const size_t exact = build(max_error);
+                if (exact * exact_share <= m_cells || m_cells >= max_cells) {
+                    break;
+                }
+            }
+        }
+
+        double operator()(double u) const {
+            const double x = u * static_cast<double>(m_cells);
+            const size_t i = static_cast<size_t>(x);
+            if (i >= m_cells || std::isnan(m_coeffs[4 * i])) {
+                return m_exact(u);
+            }
+            const double* c = &m_coeffs[4 * i];
+            const double t = x - static_cast<double>(i);
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        }
+
+        size_t cells() const { return m_cells; }
+
+        // Share of draws that take the exact function.
+        double exact_share_of_draws() const {
+            size_t exact = 0;
+            for (size_t i = 0; i < m_cells; ++i) {
+                exact += std::isnan(m_coeffs[4 * i]) ? 1 : 0;
+            }
+            return static_cast<double>(exact) / static_cast<double>(m_cells);
+        }
+
+        // The table for (name, parameter, max_error), built by f on first use.
+        static std::shared_ptr<const icdf_table> shared(const std::string& name, double parameter, double max_error, function f) {
+            static std::mutex lock;
+            static std::map<std::tuple<std::string, double, double>, std::weak_ptr<const icdf_table>> tables;
+
+            std::lock_guard<std::mutex> guard(lock);
+            const auto key = std::make_tuple(name, parameter, max_error);
+            if (auto found = tables[key].lock()) {
+                return found;
+            }
+            // drop the tables no object holds any more, e.g. from a parameter sweep
+            for (auto it = tables.begin(); it != tables.end();) {
+                it = it->second.expired() && it->first != key ? tables.erase(it) : std::next(it);
+            }
+            auto table = std::make_shared<const icdf_table>(std::move(f), max_error);
+            tables[key] = table;
+            return table;
+        }
+
+    private:
+        static constexpr size_t initial_cells = 256;
+        static constexpr size_t max_cells = 16384;  // 512 KB of coefficients
+        static constexpr size_t exact_share = 128;  // at most 1/128 of the draws on the exact path
+        static constexpr double margin = 0.5;  // the checks sample each cell, so they ask for twice the accuracy
+
+        // Fit every cell; returns the number of cells left to the exact function.
+        size_t build(double max_error) {
+            const double h = 1.0 / static_cast<double>(m_cells);
+            m_coeffs.assign(4 * m_cells, 0.0);
+            size_t exact = 0;
+            double f0 = m_exact(0.0);
+            for (size_t i = 0; i < m_cells; ++i) {
+                const double u0 = static_cast<double>(i) * h;
+                const double f1 = m_exact(u0 + h / 3.0);
+                const double f2 = m_exact(u0 + 2.0 * h / 3.0);
+                const double f3 = m_exact(u0 + h);
+                double* c = &m_coeffs[4 * i];
+                // Newton forward differences in s = 3t, expanded in t
+                const double d1 = f1 - f0;
+                const double d2 = f2 - 2.0 * f1 + f0;
+                const double d3 = f3 - 3.0 * f2 + 3.0 * f1 - f0;
+                c[0] = f0;
+                c[1] = 3.0 * (d1 - d2 / 2.0 + d3 / 3.0);
+                c[2] = 9.0 * (d2 - d3) / 2.0;
+                c[3] = 27.0 * d3 / 6.0;
+                if (!accurate(c, u0, h, max_error)) {
+                    c[0] = std::nan("");
+                    ++exact;
+                }
+                f0 = f3;
+            }
+            return exact;
+        }
+
+        bool accurate(const double* c, double u0, double h, double max_error) const {
+            static const double checks[] = {0.0, 1.0 / 6.0, 0.5, 5.0 / 6.0, 0.97};
+            for (int k = 0; k < 4; ++k) {
+                if (!std::isfinite(c[k])) {
+                    return false;
+                }
+            }
+            for (double t : checks) {
+                const double exact = m_exact(u0 + t * h);
+                const double table = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+                if (!std::isfinite(exact) || std::fabs(table - exact) > margin * max_error * std::max(1.0, std::fabs(exact))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        function m_exact;
+        size_t m_cells {initial_cells};
+        std::vector<double> m_coeffs;  // c0..c3 per cell, c0 NaN where the exact function is used
+    };
+
+    // Inverse CDF of a density only known up to a constant. The density of a
+    // variable y is integrated with trapezoids on a grid over [lo, hi] (scaled by
+    // its peak, so log densities far below 1 do not underflow the sum); a value
+    // is a binary search of u in that CDF, a linear interpolation in the cell
+    // found, and to_x of the result. The work is the same for every u, and the
+    // accuracy is that of the grid, not of an exact method.
+    class quantile_table {
+    public:
+        using function = std::function<double(double)>;
+
+        quantile_table() = default;
+
+        quantile_table(const function& log_density, double lo, double hi, function to_x, size_t grid = 4096)
+            : m_to_x(std::move(to_x)), m_lo(lo), m_step((hi - lo) / static_cast<double>(grid)), m_cdf(grid + 1, 0.0) {
+            std::vector<double> p(grid + 1);
+            double peak = -HUGE_VAL;
+            for (size_t i = 0; i <= grid; ++i) {
+                p[i] = log_density(lo + static_cast<double>(i) * m_step);
+                if (p[i] > peak) {
+                    peak = p[i];
+                }
+            }
+            for (size_t i = 0; i <= grid; ++i) {
+                p[i] = std::isfinite(p[i]) ? std::exp(p[i] - peak) : 0.0;
+                if (i > 0) {
+                    m_cdf[i] = m_cdf[i - 1] + 0.5 * (p[i - 1] + p[i]);
+                }
+            }
+            const double total = m_cdf[grid];
+            for (size_t i = 0; i <= grid; ++i) {
+                // uniform over [lo, hi] if the density gave nothing usable
+                m_cdf[i] = total > 0 && std::isfinite(total) ? m_cdf[i] / total : static_cast<double>(i) / static_cast<double>(grid);
+            }
+        }
+
+        bool empty() const { return m_cdf.empty(); }
+
+        double operator()(double u) const {
+            const size_t last = m_cdf.size() - 1;
+            size_t i = static_cast<size_t>(std::upper_bound(m_cdf.begin(), m_cdf.end(), u) - m_cdf.begin());
+            i = std::min(std::max<size_t>(i, 1), last) - 1;
+            const double mass = m_cdf[i + 1] - m_cdf[i];
+            const double frac = mass > 0 ? std::min(1.0, (u - m_cdf[i]) / mass) : 0.0;
+            return m_to_x(m_lo + (static_cast<double>(i) + frac) * m_step);
+        }
+
+    private:
+        function m_to_x;
+        double m_lo {0.0};
+        double m_step {0.0};
+        std::vector<double> m_cdf;  // at lo + i * step, from 0 to 1
+    };
+
+}
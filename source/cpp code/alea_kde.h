@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "alea_bounded.h"
+#include "alea_normal.h"
+
+// A continuous distribution learned from a stream of values, resampled by the
+// smoothed bootstrap (Silverman, "Density estimation for statistics and data
+// analysis", 1986, 6.4): a stored value picked uniformly plus kernel noise,
+// which draws from the kernel density estimate without ever building it.
+//
+// At most capacity values are kept: either the most recent ones, in a ring,
+// or a uniform sample of everything seen, by reservoir sampling (Vitter's
+// algorithm R). Either way memory is fixed and a value in is O(1) on
+// average. Running sums of the stored values, taken about the first one and
+// summed afresh once per capacity values in so that rounding cannot build
+// up, give the spread for the automatic bandwidth, the normal reference rule
+// 1.06 sd n^(-1/5), without going through the store when a value goes out.
+//
+// The bandwidth is the standard deviation of the kernel: a gauss kernel, or
+// an Epanechnikov kernel, bounded to sqrt(5) bandwidths, drawn as Devroye's
+// median of three uniforms. With shrink, values are pulled towards the mean
+// by sqrt(1 + h^2 / sd^2), which undoes the variance the kernel adds.
+//
+// Engine is anything with a 32-bit operator(), next64() and uniform() in
+// [0, 1), like alea::engine.
+
+namespace alea {
+
+    class kde_reservoir {
+    public:
+        enum class kernel { gauss, epanechnikov };
+
+        explicit kde_reservoir(size_t capacity = 1000) { set_capacity(capacity); }
+
+        // capacity >= 1; forgets what was learned.
+        void set_capacity(size_t capacity) {
+            m_capacity = std::max<size_t>(capacity, 1);
+            clear();
+        }
+
+        void clear() {
+            m_values.clear();
+            m_values.reserve(m_capacity);
+            m_next = 0;
+            m_seen = 0;
+            m_since_sum = 0;
+            m_sum = 0.0;
+            m_sum_sq = 0.0;
+            m_stale = true;
+        }
+
+        // recent: keep the last capacity values; otherwise a uniform sample of all.
+        void set_recent(bool recent) { m_recent = recent; }
+
+        // 0 for the normal reference rule.
+        void set_bandwidth(double bandwidth) {
+            m_fixed_bandwidth = std::max(0.0, bandwidth);
+            m_stale = true;
+        }
+
+        void set_kernel(kernel k) { m_kernel = k; }
+
+        void set_shrink(bool shrink) {
+            m_shrink = shrink;
+            m_stale = true;
+        }
+
+        // Learn a value. gen only decides, past capacity, whether a value
+        // enters the reservoir and what it replaces.
+        template<class Engine>
+        void add(Engine& gen, double x) {
+            if (m_values.empty()) {
+                m_shift = x;
+            }
+            ++m_seen;
+            m_stale = true;
+            if (m_values.size() < m_capacity) {
+                m_values.push_back(x);
+                accumulate(x, 1.0);
+            } else {
+                size_t slot;
+                if (m_recent) {
+                    slot = m_next;
+                    m_next = m_next + 1 == m_capacity ? 0 : m_next + 1;
+                } else {
+                    // kept with probability capacity / seen, in place of a uniform pick
+                    const uint64_t pick = bounded(gen, m_seen);
+                    if (pick >= m_capacity) {
+                        return;
+                    }
+                    slot = static_cast<size_t>(pick);
+                }
+                accumulate(m_values[slot], -1.0);
+                m_values[slot] = x;
+                accumulate(x, 1.0);
+            }
+            if (++m_since_sum >= m_capacity) {
+                resum();
+            }
+        }
+
+        size_t size() const { return m_values.size(); }
+        size_t capacity() const { return m_capacity; }
+        unsigned long long seen() const { return m_seen; }
+
+        double mean() const {
+            return m_values.empty() ? 0.0 : m_shift + m_sum / static_cast<double>(m_values.size());
+        }
+
+        double sd() const {
+            const double n = static_cast<double>(m_values.size());
+            if (n < 2.0) {
+                return 0.0;
+            }
+            const double var = (m_sum_sq - m_sum * m_sum / n) / (n - 1.0);
+            return var > 0.0 ? std::sqrt(var) : 0.0;
+        }
+
+        double bandwidth() const {
+            if (m_fixed_bandwidth > 0.0) {
+                return m_fixed_bandwidth;
+            }
+            return 1.06 * sd() * std::pow(static_cast<double>(m_values.size()), -0.2);
+        }
+
+        // A value; size() must be > 0.
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_stale) {
+                prepare();
+            }
+            const double x = m_values[static_cast<size_t>(bounded(gen, static_cast<uint64_t>(m_values.size())))];
+            const double noise = m_prepared.h * (m_kernel == kernel::gauss ? normal(gen) : epanechnikov(gen));
+            if (m_prepared.scale == 1.0) {
+                return x + noise;
+            }
+            const double m = m_prepared.mean;
+            return m + (x - m + noise) * m_prepared.scale;
+        }
+
+    private:
+        // Bandwidth and shrink factor, worked out on the first value after the
+        // store or the settings change rather than on every value.
+        void prepare() const {
+            m_prepared.h = bandwidth();
+            m_prepared.mean = mean();
+            m_prepared.scale = 1.0;
+            const double s = sd();
+            if (m_shrink && s > 0.0) {
+                m_prepared.scale = 1.0 / std::sqrt(1.0 + m_prepared.h * m_prepared.h / (s * s));
+            }
+            m_stale = false;
+        }
+
+        // Unit variance: Devroye's median of three uniforms on [-1, 1], scaled by sqrt(5).
+        template<class Engine>
+        static double epanechnikov(Engine& gen) {
+            const double u1 = 2.0 * gen.uniform() - 1.0;
+            const double u2 = 2.0 * gen.uniform() - 1.0;
+            const double u3 = 2.0 * gen.uniform() - 1.0;
+            const double e = std::fabs(u3) >= std::fabs(u2) && std::fabs(u3) >= std::fabs(u1) ? u2 : u3;
+            return 2.2360679774997898 * e;
+        }
+
+        void accumulate(double x, double sign) {
+            const double d = x - m_shift;
+            m_sum += sign * d;
+            m_sum_sq += sign * d * d;
+        }
+
+        void resum() {
+            m_since_sum = 0;
+            m_shift = m_values.front();
+            m_sum = 0.0;
+            m_sum_sq = 0.0;
+            for (double x : m_values) {
+                accumulate(x, 1.0);
+            }
+        }
+
+        std::vector<double> m_values;
+        size_t m_capacity {1000};
+        size_t m_next {0};              // ring: slot of the oldest value
+        unsigned long long m_seen {0};  // values learned since clear()
+        size_t m_since_sum {0};
+        double m_shift {0.0};           // sums are of x - shift
+        double m_sum {0.0};
+        double m_sum_sq {0.0};
+        bool m_recent {true};
+        double m_fixed_bandwidth {0.0};
+        kernel m_kernel {kernel::gauss};
+        bool m_shrink {false};
+        struct prepared {
+            double h {0.0};
+            double mean {0.0};
+            double scale {1.0};  // 1 / sqrt(1 + h^2 / sd^2) with shrink
+        };
+        mutable prepared m_prepared;
+        mutable bool m_stale {true};
+    };
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// The longest list that generate N and pattern N output, in values, so that a
+// mistyped count is refused instead of allocating gigabytes in the scheduler
+// thread.
+
+namespace alea {
+
+    constexpr size_t max_list_size = 65536;
+
+    // The largest count of items of size values each that fits in one list.
+    inline long max_list_count(size_t size = 1) {
+        return static_cast<long>(max_list_size / std::max<size_t>(size, 1));
+    }
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "alea_alias.h"
+#include "alea_normal.h"
+#include "alea_gamma.h"
+#include "alea_vonmises.h"
+
+// A mixture of K weighted components, each a gauss, laplace, uniform or von
+// Mises distribution with its own two parameters. A value is one component
+// picked from an alias table of the weights, then one draw from it, so the
+// cost does not grow with K. The table and the von Mises constants are
+// prepared when components or weights change, in prepare().
+//
+// Engine is anything with a 32-bit operator(), next64() and uniform() in
+// [0, 1), like alea::engine.
+
+namespace alea {
+
+    class mixture_sampler {
+    public:
+        enum class kind { gauss, laplace, uniform, vonmises };
+
+        // gauss: mean, sigma > 0; laplace: mean, lambda > 0; uniform: low, high;
+        // vonmises: mean angle, kappa >= 0.
+        struct component {
+            kind type {kind::gauss};
+            double a {0.0};
+            double b {1.0};
+            double weight {1.0};
+            vonmises_sampler angle;
+        };
+
+        void clear() {
+            m_components.clear();
+            m_choice = alias_table();
+        }
+
+        void add(kind type, double a, double b, double weight) {
+            component c;
+            c.type = type;
+            c.a = a;
+            c.b = b;
+            c.weight = weight;
+            if (type == kind::vonmises) {
+                c.angle.set(a, b);
+            }
+            m_components.push_back(c);
+        }
+
+        // weights.size() must be size()
+        void set_weights(const std::vector<double>& weights) {
+            for (size_t i = 0; i < m_components.size(); ++i) {
+                m_components[i].weight = weights[i];
+            }
+        }
+
+        // Builds the alias table; false if no component has a positive weight.
+        bool prepare() {
+            std::vector<double> weights(m_components.size());
+            for (size_t i = 0; i < m_components.size(); ++i) {
+                weights[i] = m_components[i].weight;
+            }
+            return m_choice.set(weights);
+        }
+
+        bool ready() const { return !m_choice.empty(); }
+        size_t size() const { return m_components.size(); }
+        const std::vector<component>& components() const { return m_components; }
+
+        // A value, and in index the component it came from; ready() must hold.
+        template<class Engine>
+        double operator()(Engine& gen, size_t& index) const {
+            index = m_choice(gen);
+            const component& c = m_components[index];
+            switch (c.type) {
+                case kind::gauss:
+                    return normal(gen, c.a, c.b);
+                case kind::laplace: {
+                    // one uniform in (0, 1) gives both the side and the distance
+                    const double u = open_uniform(gen);
+                    return u < 0.5 ? c.a + std::log(2.0 * u) / c.b : c.a - std::log(2.0 * (1.0 - u)) / c.b;
+                }
+                case kind::uniform:
+                    return c.a + (c.b - c.a) * gen.uniform();
+                default:
+                    return c.angle(gen);
+            }
+        }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            size_t index;
+            return (*this)(gen, index);
+        }
+
+    private:
+        std::vector<component> m_components;
+        alias_table m_choice;  // over the component weights
+    };
+
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "alea_gf2poly.h"
+#include "alea_mt19937_poly.h"
+#include "alea_state.h"
+
+#if !defined(ALEA_NO_SIMD)
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define ALEA_MT_AVX2 1
+    #elif defined(__SSE2__) || defined(_M_X64)
+        #include <emmintrin.h>
+        #define ALEA_MT_SSE2 1
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define ALEA_MT_NEON 1
+    #endif
+#endif
+
+// MT19937 (Matsumoto & Nishimura) with block regeneration of the whole 624-word
+// state, in the spirit of SFMT/dSFMT. The recurrence only reaches back 227 or
+// 397 words, so 4 (SSE2, NEON) or 8 (AVX2) consecutive words can be twisted at
+// once. The output is bit-identical to std::mt19937 and to the reference
+// genrand_int32(); define ALEA_NO_SIMD to force the scalar path.
+
+namespace alea {
+
+    class mt19937 {
+    public:
+        using result_type = uint32_t;
+
+        static constexpr int N = 624;
+        static constexpr int M = 397;
+        static constexpr uint32_t default_seed = 5489u;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        mt19937() { seed(default_seed); }
+        explicit mt19937(uint32_t s) { seed(s); }
+
+        // Seeding only records the seed: the state is filled by the first draw,
+        // so reseeding many idle instances (alea.seed) stays cheap.
+        void seed(uint32_t s) {
+            m_seed = s;
+            m_index = UNSEEDED;
+        }
+
+        result_type operator()() {
+            if (m_index >= N) {
+                refill();
+            }
+            uint32_t y = m_mt[m_index++];
+
+            // Tempering
+            y ^= (y >> 11);
+            y ^= (y << 7) & 0x9d2c5680u;
+            y ^= (y << 15) & 0xefc60000u;
+            y ^= (y >> 18);
+            return y;
+        }
+
+        void discard(unsigned long long z) {
+            while (z > 0) {
+                if (m_index >= N) {
+                    refill();
+                }
+                unsigned long long step = std::min<unsigned long long>(z, static_cast<unsigned long long>(N - m_index));
+                m_index += static_cast<int>(step);
+                z -= step;
+            }
+        }
+
+        // Skip J outputs, given q = t^J mod characteristic(). The state is read as
+        // the last N words of the raw sequence; one step of F slides that window
+        // by a word, so q(F) is the sum of the windows at the powers present in q.
+        // The sum only misses the low 31 bits of the oldest word, which no later
+        // word depends on and which is never output again: m_index is at least 1
+        // between calls.
+        void jump(const gf2poly& q) {
+            if (m_index == UNSEEDED) {
+                initialize();
+            }
+            const int terms = q.degree() + 1;
+            std::vector<uint32_t> window(m_mt.begin(), m_mt.end());
+            window.resize(static_cast<size_t>(N + terms));
+            std::array<uint32_t, N> sum {};
+            for (int i = 0; i < terms; ++i) {
+                if (q.coeff(i)) {
+                    const uint32_t* w = window.data() + i;
+                    for (int k = 0; k < N; ++k) {
+                        sum[k] ^= w[k];
+                    }
+                }
+                window[i + N] = window[i + M] ^ mix(window[i], window[i + 1]);
+            }
+            m_mt = sum;
+        }
+
+        static constexpr size_t state_size = N + 2;
+
+        void save(state_writer& w) const {
+            w.put(m_seed);
+            w.put(static_cast<uint32_t>(m_index));
+            for (uint32_t word : m_mt) {
+                w.put(word);
+            }
+        }
+
+        // Whether state_size words hold a valid state.
+        static bool check(state_reader r) {
+            r.get();
+            return r.get() <= static_cast<uint32_t>(UNSEEDED);
+        }
+
+        void load(state_reader& r) {
+            m_seed = r.get();
+            m_index = static_cast<int>(r.get());
+            for (auto& word : m_mt) {
+                word = r.get();
+            }
+        }
+
+        // Characteristic polynomial of the recurrence (degree 19937).
+        static const gf2poly& characteristic() {
+            static const gf2poly p(mt19937_poly::characteristic, mt19937_poly::words);
+            return p;
+        }
+
+        // The default substream stride, 2^128, and its jump polynomial.
+        static constexpr int jump_log2 = 128;
+
+        static gf2poly default_jump() {
+            return gf2poly(mt19937_poly::jump_2_128, mt19937_poly::words);
+        }
+
+    private:
+        static constexpr int UNSEEDED = N + 1;
+
+        // init_genrand() from the reference implementation
+        void initialize() {
+            m_mt[0] = m_seed;
+            for (int i = 1; i < N; ++i) {
+                m_mt[i] = 1812433253u * (m_mt[i - 1] ^ (m_mt[i - 1] >> 30)) + static_cast<uint32_t>(i);
+            }
+            m_index = N;
+        }
+
+        void refill() {
+            if (m_index == UNSEEDED) {
+                initialize();
+            }
+            regenerate();
+        }
+
+        // Refill all N words of the state.
+        void regenerate() {
+            twist(0, N - M, M);
+            twist(N - M, N - 1, M - N);
+            m_mt[N - 1] = m_mt[M - 1] ^ mix(m_mt[N - 1], m_mt[0]);
+            m_index = 0;
+        }
+
+        static constexpr uint32_t MATRIX_A = 0x9908b0dfu;
+        static constexpr uint32_t UPPER_MASK = 0x80000000u;
+        static constexpr uint32_t LOWER_MASK = 0x7fffffffu;
+
+        static uint32_t mix(uint32_t u, uint32_t v) {
+            uint32_t y = (u & UPPER_MASK) | (v & LOWER_MASK);
+            return (y >> 1) ^ ((0u - (y & 1u)) & MATRIX_A);
+        }
+
+        // m_mt[k] = m_mt[k + offset] ^ mix(m_mt[k], m_mt[k + 1]) for k in [begin, end).
+        // Both ranges used by regenerate() keep k + offset at least 227 words away
+        // from k, so a vector of words never reads a lane written by itself.
+        void twist(int begin, int end, int offset) {
+            uint32_t* mt = m_mt.data();
+            int k = begin;
+#if defined(ALEA_MT_AVX2)
+            const __m256i upper = _mm256_set1_epi32(static_cast<int>(UPPER_MASK));
+            const __m256i lower = _mm256_set1_epi32(static_cast<int>(LOWER_MASK));
+            const __m256i matrix = _mm256_set1_epi32(static_cast<int>(MATRIX_A));
+            const __m256i one = _mm256_set1_epi32(1);
+            for (; k + 8 <= end; k += 8) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mt + k));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mt + k + 1));
+                __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mt + k + offset));
+                __m256i y = _mm256_or_si256(_mm256_and_si256(a, upper), _mm256_and_si256(b, lower));
+                __m256i mag = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_and_si256(y, one), one), matrix);
+                __m256i r = _mm256_xor_si256(_mm256_xor_si256(c, _mm256_srli_epi32(y, 1)), mag);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(mt + k), r);
+            }
+#elif defined(ALEA_MT_SSE2)
+            const __m128i upper = _mm_set1_epi32(static_cast<int>(UPPER_MASK));
+            const __m128i lower = _mm_set1_epi32(static_cast<int>(LOWER_MASK));
+            const __m128i matrix = _mm_set1_epi32(static_cast<int>(MATRIX_A));
+            const __m128i one = _mm_set1_epi32(1);
+            for (; k + 4 <= end; k += 4) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mt + k));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mt + k + 1));
+                __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mt + k + offset));
+                __m128i y = _mm_or_si128(_mm_and_si128(a, upper), _mm_and_si128(b, lower));
+                __m128i mag = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(y, one), one), matrix);
+                __m128i r = _mm_xor_si128(_mm_xor_si128(c, _mm_srli_epi32(y, 1)), mag);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(mt + k), r);
+            }
+#elif defined(ALEA_MT_NEON)
+            const uint32x4_t upper = vdupq_n_u32(UPPER_MASK);
+            const uint32x4_t lower = vdupq_n_u32(LOWER_MASK);
+            const uint32x4_t matrix = vdupq_n_u32(MATRIX_A);
+            const uint32x4_t one = vdupq_n_u32(1u);
+            for (; k + 4 <= end; k += 4) {
+                uint32x4_t a = vld1q_u32(mt + k);
+                uint32x4_t b = vld1q_u32(mt + k + 1);
+                uint32x4_t c = vld1q_u32(mt + k + offset);
+                uint32x4_t y = vorrq_u32(vandq_u32(a, upper), vandq_u32(b, lower));
+                uint32x4_t mag = vandq_u32(vtstq_u32(y, one), matrix);
+                uint32x4_t r = veorq_u32(veorq_u32(c, vshrq_n_u32(y, 1)), mag);
+                vst1q_u32(mt + k, r);
+            }
+#endif
+            for (; k < end; ++k) {
+                mt[k] = mt[k + offset] ^ mix(mt[k], mt[k + 1]);
+            }
+        }
+
+        std::array<uint32_t, N> m_mt;
+        int m_index {UNSEEDED};
+        uint32_t m_seed {default_seed};
+    };
+
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+
+// Polynomials of MT19937 over GF(2), as 64-bit words with the coefficient of
+// t^0 in bit 0 of the first word. They were computed with alea::gf2poly from
+// the generator's own output (Berlekamp-Massey over 2 x 19937 bits, then 128
+// squarings) and are kept here so that no instance pays for that at run time.
+
+namespace alea {
+    namespace mt19937_poly {
+
+        constexpr int words = 312;
+
+        // Characteristic polynomial of the recurrence, degree 19937.
+        constexpr uint64_t characteristic[words] = {
+            0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000002000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000100ULL, 0x0000000000000000ULL,
+            0x0002000000000000ULL, 0x0000080000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000004000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x2000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000200000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0100000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000008000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x4000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000200000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000008000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000400ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000020000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000020000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000002ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000020000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000002000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0020000000000000ULL, 0x0000002000000000ULL, 0x0000000080000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000100ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000080000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000004000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000200000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000200000000000ULL, 0x0002000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000010000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000020ULL,
+            0x0000000000000200ULL, 0x0000000000000000ULL, 0x0000010000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000020000ULL, 0x0000000000200800ULL, 0x0000000000008000ULL,
+            0x0200000000000000ULL, 0x0100400000000000ULL, 0x0000000000000000ULL, 0x0000000020000000ULL,
+            0x0000000000000000ULL, 0x0000000008000000ULL, 0x0000000000000000ULL, 0x0000000000000021ULL,
+            0x4000000000000000ULL, 0x0000020000000000ULL, 0x0000010000000000ULL, 0x0000000020000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0020000000000000ULL,
+            0x0000800000000000ULL, 0x0000020000000000ULL, 0x0000000000000000ULL, 0x0000000021000000ULL,
+            0x0000000000000000ULL, 0x0000000000001000ULL, 0x0800000000000002ULL, 0x0020000000000001ULL,
+            0x0000000000000000ULL, 0x0000020000000000ULL, 0x0000000840000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000020000ULL, 0x0800000000000042ULL, 0x0020000000000000ULL,
+            0x0000000000000000ULL, 0x0000001000000000ULL, 0x0000000000000000ULL, 0x0000000021000000ULL,
+            0x0000000000000000ULL, 0x0000000000000080ULL, 0x0000000000000002ULL, 0x0020000000000001ULL,
+            0x0000040000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000002000ULL, 0x0000000000000080ULL, 0x0000000000000002ULL, 0x0021000000000000ULL,
+            0x0000000000000000ULL, 0x0000001000000000ULL, 0x0000000000000000ULL, 0x0000000001080000ULL,
+            0x0000000000002000ULL, 0x0000000000000000ULL, 0x0840000000000002ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000020000000000ULL, 0x0000000042000000ULL, 0x0000000000080000ULL,
+            0x0000000000002000ULL, 0x1000000000000000ULL, 0x0000000000000000ULL, 0x0021000000000000ULL,
+            0x0000000000000000ULL, 0x0000000080000000ULL, 0x0000000002000000ULL, 0x0000000001000000ULL,
+            0x0000000000002000ULL, 0x0000000000000004ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000002000000000ULL, 0x0000000080000000ULL, 0x0000000002000000ULL, 0x0000000000000000ULL,
+            0x0000000000002100ULL, 0x1000000000000000ULL, 0x0000000000000000ULL, 0x0001080000000000ULL,
+            0x0000002000000000ULL, 0x0000000000000000ULL, 0x0000000002000000ULL, 0x0000000000084000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0042000000000000ULL, 0x0000080000000000ULL,
+            0x0000002000000000ULL, 0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000000ULL,
+            0x0000000000000100ULL, 0x0080000000000000ULL, 0x0002000000000000ULL, 0x0000000000000000ULL,
+            0x0000002000000000ULL, 0x0000000004000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x2000000000000000ULL, 0x0080000000000000ULL, 0x0002000000000000ULL, 0x0000000000000000ULL,
+            0x0000000100000000ULL, 0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000000ULL,
+            0x2000000000000008ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000004000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000200ULL,
+            0x0000000000000008ULL, 0x0000000000000000ULL, 0x0000100000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000008000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0004000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000200000000ULL
+        };
+
+        // t^(2^128) mod characteristic: the default substream stride.
+        constexpr uint64_t jump_2_128[words] = {
+            0xb5709ec472de3963ULL, 0xa823f8e588279bb6ULL, 0x041f225926d83e59ULL, 0x8b521777e7fdbb15ULL,
+            0xbf2812d548b5e756ULL, 0x0b4849aae4b0adb9ULL, 0xe96d39ce3e928b83ULL, 0x09eaf2e8af6131d3ULL,
+            0xc1814c7b33548456ULL, 0xfebd07bc893a7c83ULL, 0x5147dcbf01bd8267ULL, 0x9afef574e2a67de6ULL,
+            0xf0d3decab8334d09ULL, 0xd884703b5561fd58ULL, 0xb39b8f42ef5c803bULL, 0xd61cfed320dfb761ULL,
+            0x47416177cf5f3e5bULL, 0x8ea9cfab8e8442e9ULL, 0x60ddf78d585d0ec0ULL, 0xf0f7d60e2c9b8528ULL,
+            0xca3ee37db2bb3bfcULL, 0x870ed96981c9e659ULL, 0xce5248519573a0deULL, 0x73cda5ed77683b94ULL,
+            0xf43b956c56bcfcbcULL, 0xbf04b4001f91de14ULL, 0x1d8598319438c481ULL, 0x9d97aed5ca6ae0a2ULL,
+            0xe75c95199e464218ULL, 0xcd43455c253c5486ULL, 0x7f8282d473b5ccd8ULL, 0x192ddf99c8cacd44ULL,
+            0x5288b589d6be8546ULL, 0x9819557fb4f26ca7ULL, 0x03e73d28200570ebULL, 0x78a114c9264acc04ULL,
+            0x42eee89795f0fb7bULL, 0x67e751e8abcc80c2ULL, 0x140e87ef1330cc85ULL, 0xd3f8525e913b9a96ULL,
+            0x1ba1158f3ee3d205ULL, 0x1f6aa87d2c4cdb89ULL, 0x878b32239b5e9a3aULL, 0xa48c7778a498c3edULL,
+            0x1d08f055974ac066ULL, 0xd6de80e9c8a08242ULL, 0x2892ce4ca1cf0b40ULL, 0x604168ae842731c7ULL,
+            0xbecff8b2dd23ee6dULL, 0xa4369751dfac7287ULL, 0x4a5840d9ba8bc89dULL, 0xf53bdbeda7a58582ULL,
+            0xa4149d1ccfba4997ULL, 0xf2c72905d5c66fc3ULL, 0xae4d8e96ce68ad39ULL, 0xc588f396f213a9b5ULL,
+            0x2c618d4e9d6116bbULL, 0xebfb61f3b34420d1ULL, 0xcbdca6f23b702ed7ULL, 0xbe2833957cb78166ULL,
+            0x20c0d09603a2436aULL, 0xbf49b815e190aa6fULL, 0x9b45b90349d78dc3ULL, 0x67eb90e30aa4c4c8ULL,
+            0x7f5ceab1f32b13f0ULL, 0x641eaedbccc48294ULL, 0x80b553586d6aafb6ULL, 0xf1fa779a72b55832ULL,
+            0x8992aefd3b60af74ULL, 0x283594724fa609f2ULL, 0x527dc1a961e7aaf1ULL, 0xbcad693f834e8087ULL,
+            0x95171796c9ca3bf6ULL, 0xb7d367759f41164aULL, 0x5c77677bcf20cf3bULL, 0x47dfd69ff4765b01ULL,
+            0xd708247fd90d6e15ULL, 0xad7996285fe95113ULL, 0xfcfb0ce2c627f9f2ULL, 0x4b0033800f2441ceULL,
+            0x50fa780b72161100ULL, 0xb71ca8b71f72b11aULL, 0x5475baceffab42fdULL, 0x356eef7891c28b39ULL,
+            0xdc80086d1441c9c3ULL, 0xb5c30ec996c47491ULL, 0xa9321adda254e42dULL, 0xc30bee5b963a3612ULL,
+            0xdf141323635c75c7ULL, 0x8926e38f38308f58ULL, 0x897754d871b69592ULL, 0x5bc061743cddde5eULL,
+            0xbebb80a7ad520904ULL, 0xd91d5d335cc284d4ULL, 0x11090e418c6ba748ULL, 0x462cffbc33bb9929ULL,
+            0xefc68605c42a508eULL, 0x230e6cd9602a3a14ULL, 0x49b8eb3126c6f9f4ULL, 0x7c49e7a451bd358fULL,
+            0x1910bb3947b592cbULL, 0xad0ca5183ced6a5bULL, 0xd98ca57993461dcbULL, 0xecc5cb659526948eULL,
+            0x0bddc87dfd1a431bULL, 0x7d9820ac5d694024ULL, 0x716c1ae1ffeb5538ULL, 0x04f8ed8613cffb2fULL,
+            0x1b32eb97d777f039ULL, 0x893da4ee87c1a95fULL, 0x965118d4c235f16cULL, 0xf99023e2e87994baULL,
+            0x891268a5bb8c4545ULL, 0x4d163861e7cf46b4ULL, 0xca688c0e0b2c5681ULL, 0xb86346b536702e5fULL,
+            0x72a6013755e311bbULL, 0x47d10e13142fdc5cULL, 0xac088c30a34ce0cbULL, 0x4d79a2e88f9503feULL,
+            0x02b4c095937670c7ULL, 0x080533c020f8f5e0ULL, 0xab1d0c2581fe8f32ULL, 0xb601bb28048f776dULL,
+            0xf8b8e16e96004a47ULL, 0x4a9fa0426862af7bULL, 0x54384ad4b0b6f662ULL, 0x81670a57a350c0eeULL,
+            0x3a2c282026061dc1ULL, 0xb9749667b575f899ULL, 0xaa853838738dfc2aULL, 0xa53a92a400ccc442ULL,
+            0xbdc8cfa2cfaf5a3eULL, 0x529fee9d09884265ULL, 0x966c709ea4d7f84fULL, 0xd14265d44c80bc42ULL,
+            0xb23c2aedf5ebe7f3ULL, 0xb7d47c42804523f1ULL, 0x73370568a7cb0aa9ULL, 0x66158a1e06d90ac5ULL,
+            0xc4a3898c9805c7adULL, 0x7fc536907890addeULL, 0xc5427e0885c39b20ULL, 0x2fba05edc0c864f8ULL,
+            0x210ad2bfc365017aULL, 0x609ca0038ffb95eaULL, 0x84e663c48e6c4f72ULL, 0x753c1ca83c110562ULL,
+            0x48642afc8700b723ULL, 0xcef1123e14ac952cULL, 0xf075b8b8ed84973cULL, 0xf00a255a0ceac5c9ULL,
+            0x7e77e0dadfcd487cULL, 0x0071cb978be5750cULL, 0x28c4386f560827feULL, 0xbf6b3ad6af4049f0ULL,
+            0x2e3006d1a911aaddULL, 0x2e8489f95eb5bb74ULL, 0x84278164c36fb83dULL, 0x61e0e6be82302b47ULL,
+            0x11b59c560422260eULL, 0x9cd5ecaae4f20c9cULL, 0x9bc72523f866e2daULL, 0x816f533c52c41667ULL,
+            0xa0dbff9e47a3235eULL, 0xea9ca5a30c62a756ULL, 0xc51267e9de0761a6ULL, 0xf28b88663eed2af6ULL,
+            0xfd769663695ed01fULL, 0xbc47fcdf9065af4eULL, 0x424e389cdfca6259ULL, 0xbb03335e166c2c1bULL,
+            0xc4be33dd2a73a1a1ULL, 0x45746bc2e690d058ULL, 0x07d38d7f94b43407ULL, 0x74b851e460854fb3ULL,
+            0xd99df507db3d2ac2ULL, 0x5d6c254c86d3323bULL, 0xb4dd303282bfac22ULL, 0xb7261a5fb27e023bULL,
+            0x40f361bf34fe8179ULL, 0xe716500e6c9e7858ULL, 0x35c6ee0b65873b06ULL, 0xe4c5d4fcfb2864e7ULL,
+            0x858ee284281901c6ULL, 0x44803a65e5fca3cdULL, 0xf9f41e41f850f7f6ULL, 0x87cbf3c965eb5539ULL,
+            0xae056412be2f8074ULL, 0xd8fe916f3c5cb955ULL, 0xd18ccb5eaec289dfULL, 0x446157f20eef81bfULL,
+            0xde9821754690364aULL, 0xd094591bc1597ea0ULL, 0x79676e7ab1ed3e17ULL, 0xa283bdf6c495ebc1ULL,
+            0x6a06b25c648c3570ULL, 0x0deb138c398b0580ULL, 0x4e3d096ae51108edULL, 0xafde012b1dda7416ULL,
+            0xcb001892722f0317ULL, 0x82d756d223875cf7ULL, 0x2091ce44c99114deULL, 0x8a944ef9d24757b4ULL,
+            0xedf8f12b8594145aULL, 0xf30c0ce9998c4affULL, 0xba657a589ce601a0ULL, 0x94e6ec8d36a851ddULL,
+            0x86ada470ed46b938ULL, 0x46c714b9409b507dULL, 0xb628043e05c862a8ULL, 0x8d763a8c7ac4a188ULL,
+            0x7f5ba7970adc18b6ULL, 0x5db4bc6b69073599ULL, 0x3d087e22444d59d3ULL, 0x61466f51e9c04e89ULL,
+            0x151fd405548aa4e6ULL, 0x6090566191555389ULL, 0x3e3c85615e8d5619ULL, 0x2491156c39c6b81cULL,
+            0x17b4d42cfc2fd4a6ULL, 0x2bd704cf82c9bcf9ULL, 0x054032407b2568ecULL, 0x7e037b6b5d2268d9ULL,
+            0x231f10e7d86bec7aULL, 0x964f8501ba016830ULL, 0x9873c321a3b7321fULL, 0xa5a250e1350ac2ddULL,
+            0xc738d24726578385ULL, 0xcd33873c012541caULL, 0xd0cdc82cc5907f19ULL, 0x5656cca45c2b540aULL,
+            0xa3d987b81f887dd1ULL, 0x06a2847883e7fe48ULL, 0x465f2df8945682dbULL, 0xfac8ffbc9b494ce1ULL,
+            0xb12ac825598f39cdULL, 0x3e5c217efa99231bULL, 0xe550fdba3b2d8ba2ULL, 0x846a67338e510006ULL,
+            0xee48a9263e573194ULL, 0x41c394c85ccd36bdULL, 0xa19b67f210a79620ULL, 0x8a285c068b3fd2a6ULL,
+            0x3637050a3a1797d9ULL, 0x7295647e63dfca07ULL, 0xbe8e76017a7b3bbaULL, 0x3c1e511aea660549ULL,
+            0x06c40c25c7a1931aULL, 0x7d1886643796cf70ULL, 0xb9f70031ccd9fa38ULL, 0x87fe9735601e2c75ULL,
+            0xef645dd6f8cd68b0ULL, 0x535d71387d05b323ULL, 0x90327a265c02f47fULL, 0xabd5ea2563ecd3b2ULL,
+            0x302c164101624325ULL, 0x1cdfa6bcdbfbeb93ULL, 0xb15987ed866519a2ULL, 0x0c31ec84113296f1ULL,
+            0xb4132090232a35b2ULL, 0x535172e392d0c3c5ULL, 0xfc24a0a9095ffccbULL, 0x2546326e932c038eULL,
+            0x1bbafc54ccc15e47ULL, 0xa84866303cf2a838ULL, 0x8405b4ae1057e025ULL, 0x1eec4c73da36738dULL,
+            0x4f9ff10488b30f90ULL, 0x6eab7da885eea780ULL, 0x6fe9593d40d9fdbeULL, 0x65606c0c3c850d3cULL,
+            0x70308a34b078a231ULL, 0x6d9a7cbe635af9bdULL, 0x63660519ed73ee32ULL, 0x0e62955f1701dd8dULL,
+            0x9cb66a13180db0e9ULL, 0x78fb88aad3c2cd3eULL, 0xa2859c5285fdbe48ULL, 0x902ffd419579f8f8ULL,
+            0x1f5e048a4b7c6a7bULL, 0x706d24958e262d89ULL, 0x816d7f42ebbbd878ULL, 0x3e6cc58a88cdfbf1ULL,
+            0xaa7dfafd754a64abULL, 0xb63cd2f7e98d0a02ULL, 0x72c5b57f38c8c85cULL, 0xe479da34b97f2b0aULL,
+            0x7c86232a553e33f7ULL, 0xedc6266db35cc8f8ULL, 0x14b7f688ca67e7feULL, 0xb3d3d66f072d997bULL,
+            0x121005b9528c6a42ULL, 0x87d31f390df2b622ULL, 0xedaedb3712ce5fd4ULL, 0x8e53ff2549dec2f4ULL,
+            0x764041aae79e435aULL, 0xb359bd5e29a3ee70ULL, 0x303acd045aa2b047ULL, 0x165795c2b82a2d07ULL,
+            0x950faac1a64ab733ULL, 0xff195e03dfa2861fULL, 0x5eb360ec8cd6e865ULL, 0x19e1a74d639cb063ULL,
+            0x775c20d67ec12528ULL, 0x08722d7fa44c4ddfULL, 0x83d145bcb0c92d32ULL, 0x73da60e43b2207e8ULL,
+            0x962813b9a13d0929ULL, 0xeb6572d6738f420bULL, 0x80a4a0ef151a52caULL, 0x0000000023eee457ULL
+        };
+
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "alea_normal.h"
+
+// Correlated normal vectors: x = mu + L z, with z standard normals from the
+// ziggurat and L the lower Cholesky factor of the covariance, L L^T = C. The
+// factor is computed once in set_covariance(), O(d^3); a vector then costs d
+// normals and a triangular product, d (d + 1) / 2 multiply-adds. The product
+// runs from the last row up, so that it can overwrite z in the output, and a
+// vector needs no memory beyond the output.
+//
+// Semidefinite covariances (a parameter that is a combination of others, a
+// zero variance) are accepted: a pivot that vanishes against the diagonal it
+// came from gives a zero column, and rank() counts the columns left.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class mvnormal {
+    public:
+        mvnormal() { identity(1); }
+
+        // Zero mean and identity covariance in d dimensions.
+        void identity(size_t d) {
+            m_mean.assign(d, 0.0);
+            m_factor.assign(d * (d + 1) / 2, 0.0);
+            for (size_t i = 0; i < d; ++i) {
+                m_factor[row(i) + i] = 1.0;
+            }
+            m_rank = d;
+        }
+
+        // Keeps the covariance; mean.size() must be dimension().
+        void set_mean(const std::vector<double>& mean) {
+            m_mean = mean;
+        }
+
+        // Full d x d covariance, row by row, symmetrized as (C + C^T) / 2. Returns
+        // false, keeping the previous factor, if C is not positive semidefinite.
+        bool set_covariance(const std::vector<double>& c) {
+            const size_t d = m_mean.size();
+            const double* m = c.data();
+            std::vector<double> factor(d * (d + 1) / 2, 0.0);
+            size_t rank = 0;
+            for (size_t j = 0; j < d; ++j) {
+                const double diagonal = m[j * d + j];
+                double pivot = diagonal;
+                for (size_t k = 0; k < j; ++k) {
+                    pivot -= factor[row(j) + k] * factor[row(j) + k];
+                }
+                const double tolerance = 1e-12 * std::max(std::fabs(diagonal), 1e-300);
+                if (pivot < -tolerance) {
+                    return false;
+                }
+                if (pivot <= tolerance) {
+                    // dependent on the earlier dimensions: column j stays zero,
+                    // provided the rest of row i agrees
+                    for (size_t i = j + 1; i < d; ++i) {
+                        double rest = 0.5 * (m[i * d + j] + m[j * d + i]);
+                        for (size_t k = 0; k < j; ++k) {
+                            rest -= factor[row(i) + k] * factor[row(j) + k];
+                        }
+                        if (std::fabs(rest) > 1e-9 * std::sqrt(std::fabs(m[i * d + i] * diagonal)) + 1e-300) {
+                            return false;
+                        }
+                    }
+                    continue;
+                }
+                const double l_jj = std::sqrt(pivot);
+                factor[row(j) + j] = l_jj;
+                ++rank;
+                for (size_t i = j + 1; i < d; ++i) {
+                    double sum = 0.5 * (m[i * d + j] + m[j * d + i]);
+                    for (size_t k = 0; k < j; ++k) {
+                        sum -= factor[row(i) + k] * factor[row(j) + k];
+                    }
+                    factor[row(i) + j] = sum / l_jj;
+                }
+            }
+            m_factor.swap(factor);
+            m_rank = rank;
+            return true;
+        }
+
+        size_t dimension() const { return m_mean.size(); }
+        size_t rank() const { return m_rank; }
+        const std::vector<double>& mean() const { return m_mean; }
+
+        // One vector into out[0 .. d).
+        template<class Engine>
+        void operator()(Engine& gen, double* out) const {
+            normal(gen, out, m_mean.size());
+            transform(out);
+        }
+
+        // Batch path: n vectors one after another, n * d values.
+        template<class Engine>
+        void operator()(Engine& gen, double* out, size_t n) const {
+            const size_t d = m_mean.size();
+            normal(gen, out, n * d);
+            for (size_t v = 0; v < n; ++v) {
+                transform(out + v * d);
+            }
+        }
+
+    private:
+        static size_t row(size_t i) { return i * (i + 1) / 2; }
+
+        // z -> mu + L z in place, bottom row first: row i reads z[0 .. i] only.
+        void transform(double* z) const {
+            for (size_t i = m_mean.size(); i-- > 0;) {
+                const double* l = m_factor.data() + row(i);
+                double sum = 0.0;
+                for (size_t k = 0; k <= i; ++k) {
+                    sum += l[k] * z[k];
+                }
+                z[i] = m_mean[i] + sum;
+            }
+        }
+
+        std::vector<double> m_mean;
+        std::vector<double> m_factor;  // L, packed by rows: row i holds L[i][0 .. i]
+        size_t m_rank {0};
+    };
+
+}
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Standard normal variates with the ziggurat method (Marsaglia and Tsang, "The
+// ziggurat method for generating random variables", 2000), 256 layers over 64-bit
+// draws as in Doornik's ZIGNOR. About 99% of the draws take the fast path: one
+// integer comparison and one multiplication. The tables are literals rather
+// than computed at load time.
+//
+// A seeded engine gives the same variates, bit for bit, on every platform: the
+// tail and the wedges use the exp and log1p below, built from +, -, *, / and
+// exact scalings only, rather than the libm of the platform, and the build
+// turns off the contraction of a * b + c into FMAs (-ffp-contract=off in
+// source/CMakeLists.txt), which arm64 would otherwise do and x86-64 not.
+// Known answer: with alea::engine e(1) (mt19937), the 14705th value of
+// normal(e) is the first from the tail, -0x1.004f03179d7cdp+2.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    inline constexpr double ziggurat_r = 3.6541528853610088;  // start of the tail
+    inline constexpr double ziggurat_inv_r = 1.0 / ziggurat_r;
+
+    // Layer i: draws below ziggurat_k[i] (52 bits) fall inside the rectangle and
+    // are accepted; ziggurat_w[i] scales them to x, ziggurat_f[i] is exp(-x^2/2)
+    // at the layer edge. Layer 0 is the base strip with the tail.
+    inline constexpr uint64_t ziggurat_k[256] = {
+        0xef33d8025bc39ULL, 0x0000000000000ULL, 0xc08be98f2acaaULL, 0xda354faba4236ULL,
+        0xe51f67ec049b5ULL, 0xeb255e9d2fa41ULL, 0xeef4b817e221cULL, 0xf19470af9cc80ULL,
+        0xf37ed61ff712fULL, 0xf4f469560df95ULL, 0xf61a5e41b6be3ULL, 0xf707a75536926ULL,
+        0xf7cb2ec281ec3ULL, 0xf86f10c6337d8ULL, 0xf8fa657830a7dULL, 0xf9724c74db926ULL,
+        0xf9da907dbe051ULL, 0xfa360f581e82eULL, 0xfa86fde5b3bbfULL, 0xfacf160d34659ULL,
+        0xfb0fb6718ac00ULL, 0xfb49f8d5368f8ULL, 0xfb7ec2366f3bdULL, 0xfbaece9a1db42ULL,
+        0xfbdab9d0402f5ULL, 0xfc03060ff6415ULL, 0xfc28210379aaaULL, 0xfc4a67ae254c2ULL,
+        0xfc6a2977ae7a3ULL, 0xfc87aa928908bULL, 0xfca325e4bd8d4ULL, 0xfcbcce9021dc6ULL,
+        0xfcd4d12f834c6ULL, 0xfceb54d8fe7e7ULL, 0xfd007bf1dc4c6ULL, 0xfd1464dd6c0baULL,
+        0xfd272a8e2f060ULL, 0xfd38e4ff0c565ULL, 0xfd49a9990b0f2ULL, 0xfd598b8920bf9ULL,
+        0xfd689c08e96bdULL, 0xfd76ea9c8e52aULL, 0xfd848547b0606ULL, 0xfd9178bad29cbULL,
+        0xfd9dd07a7ab31ULL, 0xfda9970105c08ULL, 0xfdb4d5dc02bb8ULL, 0xfdbf95c5bfa83ULL,
+        0xfdc9debb99848ULL, 0xfdd3b8118707fULL, 0xfddd288342d86ULL, 0xfde6364369d6fULL,
+        0xfdeee708d4f6dULL, 0xfdf7401a6b25eULL, 0xfdff46599eb80ULL, 0xfe06fe4bc2343ULL,
+        0xfe0e6c225a0b8ULL, 0xfe1593c28b6baULL, 0xfe1c78cbc3e15ULL, 0xfe231e9db1b32ULL,
+        0xfe29885da1a27ULL, 0xfe2fb8fb54027ULL, 0xfe35b33558bf6ULL, 0xfe3b799cffee1ULL,
+        0xfe410e99eac3fULL, 0xfe46746d475ffULL, 0xfe4bad34c082fULL, 0xfe50baed29401ULL,
+        0xfe559f74ebb5cULL, 0xfe5a5c8e410ffULL, 0xfe5ef3e13857dULL, 0xfe6366fd90f74ULL,
+        0xfe67b75c6d47cULL, 0xfe6be661e10b4ULL, 0xfe6ff55e5f402ULL, 0xfe73e5900a617ULL,
+        0xfe77b823e9d56ULL, 0xfe7b6e3706fc3ULL, 0xfe7f08d77416bULL, 0xfe8289053efb9ULL,
+        0xfe85efb35166dULL, 0xfe893dc84079bULL, 0xfe8c741f0cdf7ULL, 0xfe8f9387d4e36ULL,
+        0xfe929cc879a62ULL, 0xfe95909d38833ULL, 0xfe986fb9399eeULL, 0xfe9b3ac7147b7ULL,
+        0xfe9df2694b62aULL, 0xfea0973abe5d4ULL, 0xfea329cf16600ULL, 0xfea5aab32948cULL,
+        0xfea81a6d5737cULL, 0xfeaa797de1c56ULL, 0xfeacc85f3d889ULL, 0xfeaf07865e5a9ULL,
+        0xfeb13762feb82ULL, 0xfeb3585fe29bdULL, 0xfeb56ae316229ULL, 0xfeb76f4e28470ULL,
+        0xfeb965fe61f8dULL, 0xfebb4f4cf9cf9ULL, 0xfebd2b8f4494fULL, 0xfebefb16e2dbfULL,
+        0xfec0be31ebd6cULL, 0xfec2752b1599aULL, 0xfec42049daf5bULL, 0xfec5bfd29f121ULL,
+        0xfec75406cee81ULL, 0xfec8dd2500c42ULL, 0xfeca5b6911ea1ULL, 0xfecbcf0c42790ULL,
+        0xfecd38454faa9ULL, 0xfece97488c84aULL, 0xfecfec47f914fULL, 0xfed13773584c1ULL,
+        0xfed278f84489eULL, 0xfed3b10242ee8ULL, 0xfed4dfbad580bULL, 0xfed605498c37cULL,
+        0xfed721d414f89ULL, 0xfed8357e4a924ULL, 0xfed9406a42c6dULL, 0xfeda42b85b6a9ULL,
+        0xfedb3c8746a5aULL, 0xfedc2df4165faULL, 0xfedd171a46dfcULL, 0xfeddf813c8a7dULL,
+        0xfeded0f90992cULL, 0xfedfa1e0fd3c1ULL, 0xfee06ae124b73ULL, 0xfee12c0d959b5ULL,
+        0xfee1e57900690ULL, 0xfee29734b64d6ULL, 0xfee34150ae46fULL, 0xfee3e3db89af0ULL,
+        0xfee47ee2982a8ULL, 0xfee51271db03cULL, 0xfee59e9407ef7ULL, 0xfee623528b3e5ULL,
+        0xfee6a0b5897a9ULL, 0xfee716c3e0733ULL, 0xfee7858327b3bULL, 0xfee7ecf7b0674ULL,
+        0xfee84d2484a6eULL, 0xfee8a60b662ffULL, 0xfee8f7accc80fULL, 0xfee94207e2598ULL,
+        0xfee9851a829aaULL, 0xfee9c0e13481aULL, 0xfee9f557273b4ULL, 0xfeea22762cc70ULL,
+        0xfeea4836b426dULL, 0xfeea668fc2d34ULL, 0xfeea7d76ed6bdULL, 0xfeea8ce04f9ceULL,
+        0xfeea94be83300ULL, 0xfeea9502963d4ULL, 0xfeea8d9c00723ULL, 0xfeea7e789761aULL,
+        0xfeea678481cecULL, 0xfeea48aa29e4aULL, 0xfeea21d22e4a2ULL, 0xfee9f2e351fedULL,
+        0xfee9bbc26aef8ULL, 0xfee97c524f2adULL, 0xfee93473c0a03ULL, 0xfee8e405574e0ULL,
+        0xfee88ae369c44ULL, 0xfee828e7f3dc9ULL, 0xfee7bdea7b854ULL, 0xfee749bff37cbULL,
+        0xfee6cc3a9bd2cULL, 0xfee64529e004dULL, 0xfee5b45a32857ULL, 0xfee51994e5785ULL,
+        0xfee474a00069eULL, 0xfee3c53e12c1eULL, 0xfee30b2e02aa7ULL, 0xfee2462ad81d4ULL,
+        0xfee175eb83c2aULL, 0xfee09a22a1417ULL, 0xfedfb27e3499cULL, 0xfedebea76213eULL,
+        0xfeddbe422044fULL, 0xfedcb0ece39a5ULL, 0xfedb964042cc6ULL, 0xfeda6dce9389cULL,
+        0xfed937237e95fULL, 0xfed7f1c38a80aULL, 0xfed69d2b9bffeULL, 0xfed538d06add3ULL,
+        0xfed3c41dea3f7ULL, 0xfed23e76a2facULL, 0xfed0a732fe617ULL, 0xfecefda07fe08ULL,
+        0xfecd4100eb78cULL, 0xfecb708956e89ULL, 0xfec98b6123096ULL, 0xfec790a0da94eULL,
+        0xfec57f50f31d4ULL, 0xfec356686c938ULL, 0xfec114cb4b30bULL, 0xfebeb948e6fa7ULL,
+        0xfebc429a0b668ULL, 0xfeb9af5ee0cb3ULL, 0xfeb6fe1c98519ULL, 0xfeb42d3ad1f75ULL,
+        0xfeb13b00b2d23ULL, 0xfeae2591a02c0ULL, 0xfeaaeae99222dULL, 0xfea788d8ee2feULL,
+        0xfea3fcffd73bcULL, 0xfea044c8dd9ceULL, 0xfe9c5d62f5612ULL, 0xfe9843ba9477aULL,
+        0xfe93f471d4700ULL, 0xfe8f6bd76c5adULL, 0xfe8aa5dc4e8bdULL, 0xfe859e07ab1c1ULL,
+        0xfe804f690a917ULL, 0xfe7ab48823396ULL, 0xfe74c751f6a7cULL, 0xfe6e8102aa1d9ULL,
+        0xfe67da0b6abafULL, 0xfe60c9f383055ULL, 0xfe5947338f718ULL, 0xfe51470977256ULL,
+        0xfe48bd436f42dULL, 0xfe3f9bffd1e0dULL, 0xfe35d35eeb171ULL, 0xfe2b5122fe4d2ULL,
+        0xfe2000399552bULL, 0xfe13c827882e8ULL, 0xfe068c4ee6783ULL, 0xfdf82b02b717dULL,
+        0xfde87c57efe7cULL, 0xfdd7509c63bceULL, 0xfdc46e529bee3ULL, 0xfdaf8f82e0252ULL,
+        0xfd985e1b2ba43ULL, 0xfd7e6ef48ced0ULL, 0xfd613adbd64d6ULL, 0xfd40149e2efdaULL,
+        0xfd1a1a7b4c772ULL, 0xfcee204761f61ULL, 0xfcba8d85e1171ULL, 0xfc7d26ecd2cdeULL,
+        0xfc32b2f1e22a1ULL, 0xfbd6581c0b7e7ULL, 0xfb606c40053d6ULL, 0xfac40582a2805ULL,
+        0xf9e971e014510ULL, 0xf89fa48a41d49ULL, 0xf66c5f7f02f1aULL, 0xf1a5a4b331a0aULL
+    };
+
+    inline constexpr double ziggurat_w[256] = {
+        0x1.f493b78164498p-51, 0x1.b8d0be3d69918p-55, 0x1.250af3c200a69p-54, 0x1.57cb9383ae550p-54,
+        0x1.801fce827fac5p-54, 0x1.a230c2e46389ep-54, 0x1.c004d2f328d93p-54, 0x1.dac2f5a6f3120p-54,
+        0x1.f32482d4807a6p-54, 0x1.04d32278c832ep-53, 0x1.0f5053b004b4ep-53, 0x1.192a6973f450ap-53,
+        0x1.227a28f78456ap-53, 0x1.2b52e38621b30p-53, 0x1.33c3fc055e9edp-53, 0x1.3bd9ec1a11c06p-53,
+        0x1.439ef8dfe170ap-53, 0x1.4b1bb363c898dp-53, 0x1.5257562196c1cp-53, 0x1.59580a70673c9p-53,
+        0x1.60231cfd82f9bp-53, 0x1.66bd261a2377ep-53, 0x1.6d2a291feca73p-53, 0x1.736dad345c6b6p-53,
+        0x1.798ad10b200f0p-53, 0x1.7f845ad45d397p-53, 0x1.855cc5341f023p-53, 0x1.8b1649e7a632cp-53,
+        0x1.90b2ea94dc2a8p-53, 0x1.96347822b1818p-53, 0x1.9b9c98e37c43bp-53, 0x1.a0eccdca3ab98p-53,
+        0x1.a62676d76d6f5p-53, 0x1.ab4ad6e0f24bap-53, 0x1.b05b16d127fd5p-53, 0x1.b5584874191dap-53,
+        0x1.ba4368e51bb30p-53, 0x1.bf1d62abea23bp-53, 0x1.c3e70f95872e0p-53, 0x1.c8a13a531630bp-53,
+        0x1.cd4c9fe7151cap-53, 0x1.d1e9f0e7fe5f7p-53, 0x1.d679d29e3510dp-53, 0x1.dafce0022edeep-53,
+        0x1.df73aa9f0ae8dp-53, 0x1.e3debb5d2292dp-53, 0x1.e83e93379ad08p-53, 0x1.ec93abdf8c395p-53,
+        0x1.f0de784efa595p-53, 0x1.f51f654d83c88p-53, 0x1.f956d9e87202bp-53, 0x1.fd8537df97991p-53,
+        0x1.00d56e041db89p-52, 0x1.02e40f5393759p-52, 0x1.04eea9e164ed4p-52, 0x1.06f565b7249f9p-52,
+        0x1.08f8690719efdp-52, 0x1.0af7d84bc0d06p-52, 0x1.0cf3d664b796dp-52, 0x1.0eec84b15b64dp-52,
+        0x1.10e203294c4bdp-52, 0x1.12d470730bf74p-52, 0x1.14c3e9f8e41d8p-52, 0x1.16b08bfc3d191p-52,
+        0x1.189a71a788c7ep-52, 0x1.1a81b51ee20a3p-52, 0x1.1c666f8f7deb3p-52, 0x1.1e48b93e088dcp-52,
+        0x1.2028a99405610p-52, 0x1.2206572c47d17p-52, 0x1.23e1d7de97a07p-52, 0x1.25bb40ca92399p-52,
+        0x1.2792a661d8bcdp-52, 0x1.29681c7199017p-52, 0x1.2b3bb62b7e880p-52, 0x1.2d0d862e172a1p-52,
+        0x1.2edd9e8cb647fp-52, 0x1.30ac10d6e0469p-52, 0x1.3278ee1f4755fp-52, 0x1.3444470261b6ap-52,
+        0x1.360e2baca1034p-52, 0x1.37d6abe05165dp-52, 0x1.399dd6fb270e9p-52, 0x1.3b63bbfb7fc17p-52,
+        0x1.3d2869855dd80p-52, 0x1.3eebede721aacp-52, 0x1.40ae571e05f24p-52, 0x1.426fb2da63591p-52,
+        0x1.44300e83bf25ap-52, 0x1.45ef773ca8993p-52, 0x1.47adf9e6685eap-52, 0x1.496ba3248525ep-52,
+        0x1.4b287f6020506p-52, 0x1.4ce49acb2d5fdp-52, 0x1.4ea0016386a9cp-52, 0x1.505abef5e1a6dp-52,
+        0x1.5214df20a50d8p-52, 0x1.53ce6d56a2c3dp-52, 0x1.558774e1b7925p-52, 0x1.574000e552644p-52,
+        0x1.58f81c60e4c4cp-52, 0x1.5aafd2323e2fbp-52, 0x1.5c672d17d3b48p-52, 0x1.5e1e37b2f5545p-52,
+        0x1.5fd4fc89f270fp-52, 0x1.618b860a2e8ffp-52, 0x1.6341de8a27a41p-52, 0x1.64f8104b6f00cp-52,
+        0x1.66ae257c960d3p-52, 0x1.6864283b0fbf7p-52, 0x1.6a1a229507dcfp-52, 0x1.6bd01e8b30f36p-52,
+        0x1.6d86261289f28p-52, 0x1.6f3c43161c483p-52, 0x1.70f27f78b3573p-52, 0x1.72a8e5168e1a6p-52,
+        0x1.745f7dc70bc13p-52, 0x1.7616535e540adp-52, 0x1.77cd6faefc22dp-52, 0x1.7984dc8ba8bcbp-52,
+        0x1.7b3ca3c8ae294p-52, 0x1.7cf4cf3daf1d9p-52, 0x1.7ead68c73ae15p-52, 0x1.80667a486b99ep-52,
+        0x1.82200dac85645p-52, 0x1.83da2ce896f32p-52, 0x1.8594e1fd1c628p-52, 0x1.875036f7a4f7ep-52,
+        0x1.890c35f47c831p-52, 0x1.8ac8e92059192p-52, 0x1.8c865aba0de35p-52, 0x1.8e44951443c0ap-52,
+        0x1.9003a297387bcp-52, 0x1.91c38dc2855bcp-52, 0x1.9384612eeddb8p-52, 0x1.954627903758cp-52,
+        0x1.9708ebb70a936p-52, 0x1.98ccb892dfdbfp-52, 0x1.9a919933f6d92p-52, 0x1.9c5798cd5ad43p-52,
+        0x1.9e1ec2b6f486dp-52, 0x1.9fe7226faa6eap-52, 0x1.a1b0c39f90b75p-52, 0x1.a37bb21a29d81p-52,
+        0x1.a547f9e0b90efp-52, 0x1.a715a724a7f4dp-52, 0x1.a8e4c64a00726p-52, 0x1.aab563e9fc731p-52,
+        0x1.ac878cd5acc36p-52, 0x1.ae5b4e18b89dep-52, 0x1.b030b4fc37800p-52, 0x1.b207cf09a6f7ep-52,
+        0x1.b3e0aa0dfe361p-52, 0x1.b5bb541ce14a1p-52, 0x1.b797db93f6101p-52, 0x1.b9764f1e5cf51p-52,
+        0x1.bb56bdb84fdbep-52, 0x1.bd3936b2e992ep-52, 0x1.bf1dc9b81874ap-52, 0x1.c10486cebefa2p-52,
+        0x1.c2ed7e5f05369p-52, 0x1.c4d8c136de693p-52, 0x1.c6c6608ec60b5p-52, 0x1.c8b66e0eb8000p-52,
+        0x1.caa8fbd367ccdp-52, 0x1.cc9e1c73bb0eap-52, 0x1.ce95e3068bacap-52, 0x1.d0906328b6a39p-52,
+        0x1.d28db1037ca23p-52, 0x1.d48de1533a181p-52, 0x1.d691096e7cc94p-52, 0x1.d8973f4d7d74dp-52,
+        0x1.daa0999204a4dp-52, 0x1.dcad2f8fc2520p-52, 0x1.debd195520a7ep-52, 0x1.e0d06fb49ae98p-52,
+        0x1.e2e74c4ea23a7p-52, 0x1.e501c99c1ae6fp-52, 0x1.e72002f97db41p-52, 0x1.e94214b2a9c5cp-52,
+        0x1.eb681c0f74c90p-52, 0x1.ed923761084f7p-52, 0x1.efc086101ca9bp-52, 0x1.f1f328ac23146p-52,
+        0x1.f42a40fb72bc7p-52, 0x1.f665f20c8dff6p-52, 0x1.f8a6604897644p-52, 0x1.faebb187101b4p-52,
+        0x1.fd360d22fc6aep-52, 0x1.ff859c118d567p-52, 0x1.00ed447d3903dp-51, 0x1.021a8028fb929p-51,
+        0x1.034a983a8f2a6p-51, 0x1.047da4e3ee5dbp-51, 0x1.05b3bf6ada3acp-51, 0x1.06ed023a716b0p-51,
+        0x1.082988f631e79p-51, 0x1.0969708e892d0p-51, 0x1.0aacd7571b15ap-51, 0x1.0bf3dd1eec4f7p-51,
+        0x1.0d3ea34aa2df9p-51, 0x1.0e8d4cf115675p-51, 0x1.0fdffefa690b2p-51, 0x1.1136e04206156p-51,
+        0x1.129219bbb4e64p-51, 0x1.13f1d69c3fab5p-51, 0x1.1556448601f9dp-51, 0x1.16bf93b9de06ep-51,
+        0x1.182df74d203f5p-51, 0x1.19a1a564edd5ap-51, 0x1.1b1ad777f2157p-51, 0x1.1c99ca9719877p-51,
+        0x1.1e1ebfbe4a036p-51, 0x1.1fa9fc2e2cb18p-51, 0x1.213bc9d04beb3p-51, 0x1.22d477a6fc63bp-51,
+        0x1.24745a4ac8e8bp-51, 0x1.261bcc7764b62p-51, 0x1.27cb2faa84bcbp-51, 0x1.2982ecd770131p-51,
+        0x1.2b4375329fd27p-51, 0x1.2d0d43196ce88p-51, 0x1.2ee0db1a96c02p-51, 0x1.30becd256a217p-51,
+        0x1.32a7b5e6897e9p-51, 0x1.349c405ae0606p-51, 0x1.369d27a339bc1p-51, 0x1.38ab3925634a9p-51,
+        0x1.3ac7570ae7cb8p-51, 0x1.3cf27b316f883p-51, 0x1.3f2dbaa60e871p-51, 0x1.417a49cb9d9f6p-51,
+        0x1.43d98155452d1p-51, 0x1.464ce44a72e74p-51, 0x1.48d62759c383dp-51, 0x1.4b7739d6b4eccp-51,
+        0x1.4e3250dcd7dccp-51, 0x1.5109f53e9a131p-51, 0x1.54011523a7359p-51, 0x1.571b1a94ad95ap-51,
+        0x1.5a5c08b718342p-51, 0x1.5dc8a243ac693p-51, 0x1.61669cf86140fp-51, 0x1.653ce7b0060dfp-51,
+        0x1.69540be9fdbedp-51, 0x1.6db6b8d09d896p-51, 0x1.72728f05f70d7p-51, 0x1.779955608fd5bp-51,
+        0x1.7d42df4d6c5c3p-51, 0x1.839030529e9c6p-51, 0x1.8ab0fbfaa7412p-51, 0x1.92ee0946f3d1ap-51,
+        0x1.9cbee014050dfp-51, 0x1.a8fdc7894718cp-51, 0x1.b981f3878f995p-51, 0x1.d3bb48209ad33p-51
+    };
+
+    inline constexpr double ziggurat_f[256] = {
+        0x1.0000000000000p+0, 0x1.f446ac97c0265p-1, 0x1.eb7545b6e5a2dp-1, 0x1.e3f11e0296bb2p-1,
+        0x1.dd36fa70635f9p-1, 0x1.d70920658fa12p-1, 0x1.d144978a24289p-1, 0x1.cbd33a8a84602p-1,
+        0x1.c6a5eceaa82b8p-1, 0x1.c1b1cd9efb947p-1, 0x1.bceeb4ee2d08dp-1, 0x1.b85653a90e040p-1,
+        0x1.b3e3a8235bfdap-1, 0x1.af92a3f6dc413p-1, 0x1.ab5fef17af9c6p-1, 0x1.a748bd5519883p-1,
+        0x1.a34aafdf6780cp-1, 0x1.9f63bee65e399p-1, 0x1.9b9228d24c563p-1, 0x1.97d4657623514p-1,
+        0x1.94291c21c3052p-1, 0x1.908f1bd322352p-1, 0x1.8d0554fe6b8dcp-1, 0x1.898ad48bb899ap-1,
+        0x1.861ebfc3863d6p-1, 0x1.82c050f577355p-1, 0x1.7f6ed4b218395p-1, 0x1.7c29a779d0627p-1,
+        0x1.78f033ca14bc9p-1, 0x1.75c1f0771708dp-1, 0x1.729e5f44002a7p-1, 0x1.6f850baeb0dfbp-1,
+        0x1.6c7589e63eb25p-1, 0x1.696f75e51c96bp-1, 0x1.667272a936f1ep-1, 0x1.637e2985595dfp-1,
+        0x1.609249880ae0ap-1, 0x1.5dae86f4b84fep-1, 0x1.5ad29acc8e01cp-1, 0x1.57fe4264d0f30p-1,
+        0x1.55313f08e1e03p-1, 0x1.526b55a65eabbp-1, 0x1.4fac4e8213283p-1, 0x1.4cf3f4f49c91ep-1,
+        0x1.4a42172dccb23p-1, 0x1.479685fdfc714p-1, 0x1.44f114a49abddp-1, 0x1.425198a35d3b3p-1,
+        0x1.3fb7e9958cdc7p-1, 0x1.3d23e10afa266p-1, 0x1.3a955a6633c57p-1, 0x1.380c32bda6eadp-1,
+        0x1.358848bf5bd57p-1, 0x1.33097c970a541p-1, 0x1.308fafd64a29fp-1, 0x1.2e1ac55eaa449p-1,
+        0x1.2baaa14d7fc57p-1, 0x1.293f28e9432dbp-1, 0x1.26d8429056971p-1, 0x1.2475d5a913eccp-1,
+        0x1.2217ca9305a04p-1, 0x1.1fbe0a992f702p-1, 0x1.1d687fe54f920p-1, 0x1.1b17157402fa1p-1,
+        0x1.18c9b709b99bdp-1, 0x1.168051286962ap-1, 0x1.143ad105f04d3p-1, 0x1.11f924831795cp-1,
+        0x1.0fbb3a232b228p-1, 0x1.0d81010419aaap-1, 0x1.0b4a68d7130b1p-1, 0x1.091761d99b381p-1,
+        0x1.06e7dccf09138p-1, 0x1.04bbcafa69335p-1, 0x1.02931e18bd539p-1, 0x1.006dc85b91cdep-1,
+        0x1.fc9778c7c5ff1p-2, 0x1.f859da7a9a13dp-2, 0x1.f4229cb301990p-2, 0x1.eff1a717f2c62p-2,
+        0x1.ebc6e20bdba59p-2, 0x1.e7a236a4f5d07p-2, 0x1.e3838ea603307p-2, 0x1.df6ad4776cfd2p-2,
+        0x1.db57f320beac8p-2, 0x1.d74ad6427709cp-2, 0x1.d3436a102a142p-2, 0x1.cf419b4aeea8ep-2,
+        0x1.cb45573c135cbp-2, 0x1.c74e8bb0163b2p-2, 0x1.c35d26f1db70fp-2, 0x1.bf7117c61f2dep-2,
+        0x1.bb8a4d671f4cdp-2, 0x1.b7a8b780798d0p-2, 0x1.b3cc462b3b5fcp-2, 0x1.aff4e9ea20806p-2,
+        0x1.ac2293a5fdbd7p-2, 0x1.a85534aa55844p-2, 0x1.a48cbea213e9ep-2, 0x1.a0c923947011ep-2,
+        0x1.9d0a55e1f0f53p-2, 0x1.9950484193ad3p-2, 0x1.959aedbe1183bp-2, 0x1.91ea39b344260p-2,
+        0x1.8e3e1fcba6703p-2, 0x1.8a9693fdf061cp-2, 0x1.86f38a8accdf4p-2, 0x1.8354f7faa7fc5p-2,
+        0x1.7fbad11b949adp-2, 0x1.7c250aff48400p-2, 0x1.78939af92c0f3p-2, 0x1.7506769c81eafp-2,
+        0x1.717d93ba9cccdp-2, 0x1.6df8e8612b6ecp-2, 0x1.6a786ad894727p-2, 0x1.66fc11a2633afp-2,
+        0x1.6383d377c4babp-2, 0x1.600fa74813828p-2, 0x1.5c9f843772671p-2, 0x1.5933619d751bcp-2,
+        0x1.55cb3703d62d1p-2, 0x1.5266fc2539c94p-2, 0x1.4f06a8ebfcd13p-2, 0x1.4baa35710fafep-2,
+        0x1.485199fadc80dp-2, 0x1.44fccefc38117p-2, 0x1.41abcd135d515p-2, 0x1.3e5e8d08f2cbbp-2,
+        0x1.3b1507cf19c77p-2, 0x1.37cf368086b2cp-2, 0x1.348d125fa283fp-2, 0x1.314e94d5b4bbep-2,
+        0x1.2e13b77215be5p-2, 0x1.2adc73e96934ep-2, 0x1.27a8c414e0385p-2, 0x1.2478a1f182fe8p-2,
+        0x1.214c079f81cf7p-2, 0x1.1e22ef618d06bp-2, 0x1.1afd539c33ea1p-2, 0x1.17db2ed54a239p-2,
+        0x1.14bc7bb353ab8p-2, 0x1.11a134fcf6f75p-2, 0x1.0e8955987541ap-2, 0x1.0b74d88b28c36p-2,
+        0x1.0863b8f908b9bp-2, 0x1.0555f22433149p-2, 0x1.024b7f6c7baf9p-2, 0x1.fe88b89e01ed8p-3,
+        0x1.f88108cb8bb6bp-3, 0x1.f27fe6cea202ap-3, 0x1.ec854a4ca21c2p-3, 0x1.e6912b228c089p-3,
+        0x1.e0a381645f35fp-3, 0x1.dabc455c81015p-3, 0x1.d4db6f8b2cf92p-3, 0x1.cf00f8a5eec4bp-3,
+        0x1.c92cd99725a10p-3, 0x1.c35f0b7d91641p-3, 0x1.bd9787abe8fdep-3, 0x1.b7d647a87a72bp-3,
+        0x1.b21b452cd4505p-3, 0x1.ac667a2578a1bp-3, 0x1.a6b7e0b1996e0p-3, 0x1.a10f7322decf1p-3,
+        0x1.9b6d2bfd36b63p-3, 0x1.95d105f6ae788p-3, 0x1.903afbf756425p-3, 0x1.8aab09192e973p-3,
+        0x1.852128a8200b0p-3, 0x1.7f9d5621fd650p-3, 0x1.7a1f8d3690665p-3, 0x1.74a7c9c7b1751p-3,
+        0x1.6f3607e96a72fp-3, 0x1.69ca43e2250e8p-3, 0x1.64647a2ae4e9cp-3, 0x1.5f04a76f8df6fp-3,
+        0x1.59aac88f3775cp-3, 0x1.5456da9c8c09dp-3, 0x1.4f08dade376a4p-3, 0x1.49c0c6cf6238ep-3,
+        0x1.447e9c203c9b4p-3, 0x1.3f4258b698410p-3, 0x1.3a0bfaae928d4p-3, 0x1.34db805b4fafap-3,
+        0x1.2fb0e847c7863p-3, 0x1.2a8c3137a53a6p-3, 0x1.256d5a283a9d2p-3, 0x1.20546251885e5p-3,
+        0x1.1b4149275c58ap-3, 0x1.16340e5a87443p-3, 0x1.112cb1da2b434p-3, 0x1.0c2b33d524dd1p-3,
+        0x1.072f94bb9023dp-3, 0x1.0239d5406be88p-3, 0x1.fa93ecb6ba232p-4, 0x1.f0bff29528b67p-4,
+        0x1.e6f7bf29b1feap-4, 0x1.dd3b561776082p-4, 0x1.d38abb9be0731p-4, 0x1.c9e5f493be6bdp-4,
+        0x1.c04d0680b802cp-4, 0x1.b6bff78f34fb7p-4, 0x1.ad3ece9cb6128p-4, 0x1.a3c9933eacaf5p-4,
+        0x1.9a604dc9dc0fep-4, 0x1.9103075a50413p-4, 0x1.87b1c9dbf893ep-4, 0x1.7e6ca013f4e4dp-4,
+        0x1.753395aaa6d7fp-4, 0x1.6c06b7369a3e7p-4, 0x1.62e612485a445p-4, 0x1.59d1b5774bb6bp-4,
+        0x1.50c9b06fa7e17p-4, 0x1.47ce1401b7223p-4, 0x1.3edef2326e83cp-4, 0x1.35fc5e4d989d0p-4,
+        0x1.2d266cf9b7a28p-4, 0x1.245d344dd5460p-4, 0x1.1ba0cbe97ce08p-4, 0x1.12f14d0f259e6p-4,
+        0x1.0a4ed2c15d631p-4, 0x1.01b979e31226fp-4, 0x1.f262c2b6ce583p-5, 0x1.e16d547b2c47cp-5,
+        0x1.d092efeae600ap-5, 0x1.bfd3e0f289491p-5, 0x1.af3079038c597p-5, 0x1.9ea90f929b758p-5,
+        0x1.8e3e02a691375p-5, 0x1.7defb77af80c9p-5, 0x1.6dbe9b3992600p-5, 0x1.5dab23cf2ff69p-5,
+        0x1.4db5d0e1174f2p-5, 0x1.3ddf2ce993869p-5, 0x1.2e27ce83e3a4fp-5, 0x1.1e9059f1fac92p-5,
+        0x1.0f1982e96be0fp-5, 0x1.ff881d7191a2cp-6, 0x1.e121adb82f964p-6, 0x1.c301983cd6ea9p-6,
+        0x1.a529f4e234a42p-6, 0x1.879d1b6011823p-6, 0x1.6a5daf40c0f87p-6, 0x1.4d6eaf2fbf966p-6,
+        0x1.30d388daba032p-6, 0x1.1490334606b67p-6, 0x1.f152a4f734696p-7, 0x1.ba48d274febdcp-7,
+        0x1.841040d8df3cap-7, 0x1.4eb96421b129fp-7, 0x1.1a5922995660bp-7, 0x1.ce160f8ecbd47p-8,
+        0x1.69ea8d90cf658p-8, 0x1.08a1f03b0d9d6p-8, 0x1.55f9f43c1d644p-9, 0x1.4a605b6b9f70fp-10
+    };
+
+
+    namespace detail {
+
+        // exp(x) from fdlibm's e_exp.c: x = k ln2 + r with |r| <= ln2 / 2, a
+        // rational approximation of exp(r), then 2^k. Within one ulp.
+        inline double ziggurat_exp(double x) {
+            constexpr double ln2_hi = 6.93147180369123816490e-01;
+            constexpr double ln2_lo = 1.90821492927058770002e-10;
+            constexpr double inv_ln2 = 1.44269504088896338700e+00;
+            constexpr double p1 = 1.66666666666666019037e-01;
+            constexpr double p2 = -2.77777777770155933842e-03;
+            constexpr double p3 = 6.61375632143793436117e-05;
+            constexpr double p4 = -1.65339022054652515390e-06;
+            constexpr double p5 = 4.13813679705723846039e-08;
+            const double k = std::floor(inv_ln2 * x + 0.5);
+            const double hi = x - k * ln2_hi;  // exact: ln2_hi has 11 trailing zero bits
+            const double lo = k * ln2_lo;
+            const double r = hi - lo;
+            const double t = r * r;
+            const double c = r - t * (p1 + t * (p2 + t * (p3 + t * (p4 + t * p5))));
+            const double y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+            return std::ldexp(y, static_cast<int>(k));
+        }
+
+        // log(x) for x > 0 from fdlibm's e_log.c: x = 2^k m with m in
+        // [sqrt(2)/2, sqrt(2)), then a series in s = (m - 1) / (m + 1). Within
+        // one ulp.
+        inline double ziggurat_log(double x) {
+            constexpr double ln2_hi = 6.93147180369123816490e-01;
+            constexpr double ln2_lo = 1.90821492927058770002e-10;
+            constexpr double lg1 = 6.666666666666735130e-01;
+            constexpr double lg2 = 3.999999999940941908e-01;
+            constexpr double lg3 = 2.857142874366239149e-01;
+            constexpr double lg4 = 2.222219843214978396e-01;
+            constexpr double lg5 = 1.818357216161805012e-01;
+            constexpr double lg6 = 1.531383769920937332e-01;
+            constexpr double lg7 = 1.479819860511658591e-01;
+            int e = 0;
+            double m = std::frexp(x, &e);  // exact, m in [0.5, 1)
+            if (m < 0.70710678118654752440) {
+                m += m;
+                --e;
+            }
+            const double k = static_cast<double>(e);
+            const double f = m - 1.0;
+            const double s = f / (2.0 + f);
+            const double z = s * s;
+            const double w = z * z;
+            const double r = z * (lg1 + w * (lg3 + w * (lg5 + w * lg7))) + w * (lg2 + w * (lg4 + w * lg6));
+            const double hfsq = 0.5 * f * f;
+            return k * ln2_hi - ((hfsq - (s * (hfsq + r) + k * ln2_lo)) - f);
+        }
+
+        // log(1 + x) for x > -1: the log of the rounded 1 + x, corrected to
+        // first order by the rounding error (Goldberg, "What every computer
+        // scientist should know about floating-point arithmetic", 1991).
+        inline double ziggurat_log1p(double x) {
+            const double v = 1.0 + x;
+            if (v == 1.0) {
+                return x;
+            }
+            return ziggurat_log(v) - ((v - 1.0) - x) / v;
+        }
+
+        // The rest of a draw that missed the rectangle of layer i: the tail
+        // beyond r for layer 0 (Marsaglia, 1964), which always ends with a
+        // value, and otherwise the wedge between the rectangle and the curve,
+        // which keeps x or returns false for a new draw.
+        template<class Engine>
+        bool ziggurat_rare(Engine& gen, int i, bool negative, double& x) {
+            if (i == 0) {
+                for (;;) {
+                    const double xx = -ziggurat_inv_r * ziggurat_log1p(-gen.uniform());
+                    const double yy = -ziggurat_log1p(-gen.uniform());
+                    if (yy + yy > xx * xx) {
+                        x = negative ? -(ziggurat_r + xx) : ziggurat_r + xx;
+                        return true;
+                    }
+                }
+            }
+            const double height = (ziggurat_f[i - 1] - ziggurat_f[i]) * gen.uniform();
+            return ziggurat_f[i] + height < ziggurat_exp(-0.5 * x * x);
+        }
+
+    }
+
+    template<class Engine>
+    double normal(Engine& gen) {
+        for (;;) {
+            uint64_t r = gen.next64();
+            const int i = static_cast<int>(r & 0xff);
+            r >>= 8;
+            const bool negative = r & 1u;
+            const uint64_t bits = (r >> 1) & 0x000fffffffffffffULL;
+            double x = static_cast<double>(bits) * ziggurat_w[i];
+            if (negative) {
+                x = -x;
+            }
+            if (bits < ziggurat_k[i] || detail::ziggurat_rare(gen, i, negative, x)) {
+                return x;
+            }
+        }
+    }
+
+    template<class Engine>
+    double normal(Engine& gen, double mu, double sigma) {
+        return mu + sigma * normal(gen);
+    }
+
+    // Batch path: n variates in one call, for list output. The words of a
+    // block are drawn first and all of them go through the fast path without
+    // a branch on the outcome, noting the few that miss their rectangle; those
+    // are finished afterwards, with further draws. The values follow the same
+    // distribution as n single calls, not the same sequence.
+    template<class Engine>
+    void normal(Engine& gen, double* out, size_t n, double mu = 0.0, double sigma = 1.0) {
+        constexpr size_t block = 64;
+        uint64_t words[block];
+        uint32_t missed[block];
+        for (size_t start = 0; start < n; start += block) {
+            const size_t count = std::min(block, n - start);
+            double* values = out + start;
+            for (size_t k = 0; k < count; ++k) {
+                words[k] = gen.next64();
+            }
+            size_t misses = 0;
+            for (size_t k = 0; k < count; ++k) {
+                const uint64_t r = words[k];
+                const int i = static_cast<int>(r & 0xff);
+                const uint64_t bits = (r >> 9) & 0x000fffffffffffffULL;
+                const double sign = (r >> 8) & 1u ? -1.0 : 1.0;
+                values[k] = mu + sigma * (sign * (static_cast<double>(bits) * ziggurat_w[i]));
+                missed[misses] = static_cast<uint32_t>(k);
+                misses += bits >= ziggurat_k[i];
+            }
+            for (size_t m = 0; m < misses; ++m) {
+                const uint64_t r = words[missed[m]];
+                const int i = static_cast<int>(r & 0xff);
+                const bool negative = (r >> 8) & 1u;
+                double x = static_cast<double>((r >> 9) & 0x000fffffffffffffULL) * ziggurat_w[i];
+                if (negative) {
+                    x = -x;
+                }
+                if (!detail::ziggurat_rare(gen, i, negative, x)) {
+                    x = normal(gen);
+                }
+                values[missed[m]] = mu + sigma * x;
+            }
+        }
+    }
+
+}
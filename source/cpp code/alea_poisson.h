@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cmath>
+
+// Poisson variates with the setup done once per lambda, in set().
+//
+// Below lambda 10 the multiplicative method is the fastest: it multiplies
+// uniforms until the product falls under the cached exp(-lambda), lambda + 1
+// draws on average. Above, it would need more and more draws, and exp(-lambda)
+// underflows at 745, so the transformed rejection with squeeze PTRS (Hoermann,
+// "The transformed rejection method for generating Poisson random variables",
+// 1993) takes over, with about 1.2 pairs of uniforms per value for any lambda.
+//
+// Engine is anything with uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class poisson_sampler {
+    public:
+        explicit poisson_sampler(double lambda = 1.0) { set(lambda); }
+
+        // lambda <= 0 always gives 0
+        void set(double lambda) {
+            m_lambda = lambda;
+            m_exp_neg_lambda = std::exp(-lambda);
+            if (lambda >= threshold) {
+                const double slam = std::sqrt(lambda);
+                m_log_lambda = std::log(lambda);
+                m_b = 0.931 + 2.53 * slam;
+                m_a = -0.059 + 0.02483 * m_b;
+                m_log_inv_alpha = std::log(1.1239 + 1.1328 / (m_b - 3.4));
+                m_vr = 0.9277 - 3.6224 / (m_b - 2.0);
+            }
+        }
+
+        double lambda() const { return m_lambda; }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            return m_lambda >= threshold ? ptrs(gen) : multiply(gen);
+        }
+
+    private:
+        static constexpr double threshold = 10.0;
+
+        template<class Engine>
+        double multiply(Engine& gen) const {
+            double n = 0.0;
+            double product = gen.uniform();
+            while (product >= m_exp_neg_lambda) {
+                n += 1.0;
+                product *= gen.uniform();
+            }
+            return n;
+        }
+
+        template<class Engine>
+        double ptrs(Engine& gen) const {
+            for (;;) {
+                const double u = gen.uniform() - 0.5;
+                const double v = gen.uniform();
+                const double us = 0.5 - std::fabs(u);
+                const double k = std::floor((2.0 * m_a / us + m_b) * u + m_lambda + 0.43);
+                if (us >= 0.07 && v <= m_vr) {
+                    return k;
+                }
+                if (k < 0.0 || (us < 0.013 && v > us)) {
+                    continue;
+                }
+                if (std::log(v) + m_log_inv_alpha - std::log(m_a / (us * us) + m_b)
+                    <= -m_lambda + k * m_log_lambda - std::lgamma(k + 1.0)) {
+                    return k;
+                }
+            }
+        }
+
+        double m_lambda {1.0};
+        double m_exp_neg_lambda {0.0};
+        double m_log_lambda {0.0};
+        double m_a {0.0};
+        double m_b {0.0};
+        double m_log_inv_alpha {0.0};
+        double m_vr {0.0};
+    };
+
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "c74_min.h"
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "alea_engine.h"
+
+// Seed groups: named sets of alea objects that alea.seed reseeds with one message.
+//
+// Every alea external is a binary of its own with its own statics, so the
+// registry is kept where all of them can reach it: in a Max object registered
+// under a private name (see shared() below). Groups are looked up by name in a hash map. Names nest with dots:
+// seeding "drums" also seeds "drums.kick" and "drums.snare", each from a master
+// derived from its parent's master and its own name. The members of a group
+// are numbered in the order they join, which is patch order when a patch
+// loads, and member n is seeded from the group master and n, so one seed
+// reproduces the whole patch. A group keeps its last master, and objects that
+// join later are seeded on arrival.
+//
+// The entropy pool of random_seed() is shared the same way.
+
+namespace alea {
+
+    namespace detail {
+
+        // The Max object that carries shared data from one external to the
+        // others. Only the fields up to version are the same in every build:
+        // data is only read by an external that finds the class, the magic and
+        // the version it expects.
+        struct shared_box {
+            c74::max::t_object header;
+            uint32_t magic;
+            uint32_t version;
+            void* data;
+        };
+
+        constexpr uint32_t shared_magic = 0x616c6561;  // "alea"
+
+        inline c74::max::t_symbol* shared_classname() {
+            return c74::max::gensym("alea.shared");
+        }
+
+        // The nobox class of the boxes, registered by the first external that
+        // needs it and found by name by the others.
+        inline c74::max::t_class* shared_class() {
+            c74::max::t_symbol* nobox = c74::max::gensym("nobox");
+            c74::max::t_class* c = c74::max::class_findbyname(nobox, shared_classname());
+            if (!c) {
+                c = c74::max::class_new(shared_classname()->s_name, nullptr, nullptr, sizeof(shared_box), nullptr, 0);
+                c74::max::class_register(nobox, c);
+            }
+            return c;
+        }
+
+    }
+
+    // The one T of the Max session registered as name, created with make() by
+    // the first external that asks for it. version numbers the layout of T:
+    // an external that finds a box of another class or layout under the name
+    // (another build of alea) keeps a T of its own rather than read it. Not
+    // freed: it lives as long as Max. Called from the main thread first.
+    template<class T, class Make>
+    T& shared(const char* name, uint32_t version, Make make) {
+        c74::max::t_symbol* name_space = c74::max::gensym("alea");
+        c74::max::t_symbol* key = c74::max::gensym(name);
+        auto* box = static_cast<detail::shared_box*>(c74::max::object_findregistered(name_space, key));
+        if (!box) {
+            box = static_cast<detail::shared_box*>(c74::max::object_alloc(detail::shared_class()));
+            box->magic = detail::shared_magic;
+            box->version = version;
+            box->data = make();
+            c74::max::object_register(name_space, key, box);
+        }
+        if (c74::max::object_classname(box) == detail::shared_classname()
+            && box->magic == detail::shared_magic && box->version == version) {
+            return *static_cast<T*>(box->data);
+        }
+        static T* own = static_cast<T*>(make());
+        return *own;
+    }
+
+    // Seed for an object created without one. The system entropy is read once
+    // per Max session and stretched with SplitMix64, so creating a patch with
+    // hundreds of objects costs a single random_device read instead of one per
+    // object, and no instance keeps a random_device of its own. The pool is
+    // shared(), like the seed registry, so that all the alea externals draw
+    // from the one pool. Thread-safe once created, which happens with the
+    // first object, in the main thread.
+    inline uint32_t random_seed() {
+        auto& pool = shared<std::atomic<uint64_t>>("seed_pool", 1, [] {
+            std::random_device rd;
+            uint64_t s = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+            // some platforms have a deterministic random_device, the clock at least
+            // tells two sessions apart
+            s ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+            return new std::atomic<uint64_t>(s);
+        });
+        splitmix64 sm(pool.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed));
+        return static_cast<uint32_t>(sm() >> 32);
+    }
+
+    class seed_link;
+
+    struct seed_group {
+        seed_group* parent {nullptr};
+        std::string leaf;  // last component of the name
+        std::vector<seed_group*> children;
+        std::vector<seed_link*> members;
+        uint64_t next_slot {0};
+        uint64_t master {0};
+        bool seeded {false};
+    };
+
+    // Seed number key of a group seeded with master.
+    inline uint64_t derive_seed(uint64_t master, uint64_t key) {
+        splitmix64 sm(master ^ (key * 0xbf58476d1ce4e5b9ULL));
+        return sm();
+    }
+
+    // The seed_link of each object joins it to a group by name and reseeds it
+    // through the object's own seeding code.
+    class seed_link {
+    public:
+        using reseed_function = std::function<void(uint32_t)>;
+
+        explicit seed_link(reseed_function f)
+            : m_reseed(std::move(f)) {}
+
+        ~seed_link() { join(""); }
+
+        seed_link(const seed_link&) = delete;
+        seed_link& operator=(const seed_link&) = delete;
+
+        // Leave the current group and join name, or no group if name is empty.
+        inline void join(const std::string& name);
+
+    private:
+        friend class seed_registry;
+
+        reseed_function m_reseed;
+        seed_group* m_group {nullptr};
+        size_t m_index {0};  // position in m_group->members
+        uint64_t m_slot {0};  // join order, the key of the member's seed
+    };
+
+    class seed_registry {
+    public:
+        // Bump layout_version with any change to the members of seed_registry,
+        // seed_group or seed_link that the registry touches.
+        static constexpr uint32_t layout_version = 1;
+
+        static seed_registry& instance() {
+            return shared<seed_registry>("seed_registry", layout_version, [] { return new seed_registry; });
+        }
+
+        // Seed a group and its subgroups. Returns the number of objects reseeded.
+        size_t seed(const std::string& name, uint64_t master) {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return seed(group(name), master);
+        }
+
+        // Objects in a group and its subgroups.
+        size_t size(const std::string& name) {
+            std::lock_guard<std::mutex> guard(m_lock);
+            auto found = m_groups.find(name);
+            return found == m_groups.end() ? 0 : size(found->second);
+        }
+
+        void join(seed_link& link, const std::string& name) {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (seed_group* g = link.m_group) {
+                seed_link* last = g->members.back();
+                g->members[link.m_index] = last;
+                last->m_index = link.m_index;
+                g->members.pop_back();
+                link.m_group = nullptr;
+            }
+            if (name.empty()) {
+                return;
+            }
+            seed_group& g = group(name);
+            link.m_group = &g;
+            link.m_index = g.members.size();
+            link.m_slot = g.next_slot++;
+            g.members.push_back(&link);
+            if (g.seeded) {
+                link.m_reseed(static_cast<uint32_t>(derive_seed(g.master, link.m_slot) >> 32));
+            }
+        }
+
+    private:
+        // The group called name, created along with its parents if needed.
+        seed_group& group(const std::string& name) {
+            auto found = m_groups.find(name);
+            if (found != m_groups.end()) {
+                return found->second;
+            }
+            seed_group& g = m_groups[name];
+            const size_t dot = name.rfind('.');
+            if (dot == std::string::npos || dot == 0) {
+                g.leaf = name;
+                return g;
+            }
+            g.leaf = name.substr(dot + 1);
+            g.parent = &group(name.substr(0, dot));
+            g.parent->children.push_back(&g);
+            if (g.parent->seeded) {
+                g.master = derive_seed(g.parent->master, hash(g.leaf));
+                g.seeded = true;
+            }
+            return g;
+        }
+
+        size_t seed(seed_group& g, uint64_t master) {
+            g.master = master;
+            g.seeded = true;
+            for (seed_link* link : g.members) {
+                link->m_reseed(static_cast<uint32_t>(derive_seed(master, link->m_slot) >> 32));
+            }
+            size_t count = g.members.size();
+            for (seed_group* child : g.children) {
+                count += seed(*child, derive_seed(master, hash(child->leaf)));
+            }
+            return count;
+        }
+
+        size_t size(const seed_group& g) const {
+            size_t count = g.members.size();
+            for (const seed_group* child : g.children) {
+                count += size(*child);
+            }
+            return count;
+        }
+
+        // FNV-1a
+        static uint64_t hash(const std::string& s) {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (unsigned char c : s) {
+                h = (h ^ c) * 0x100000001b3ULL;
+            }
+            return h;
+        }
+
+        std::mutex m_lock;
+        std::unordered_map<std::string, seed_group> m_groups;  // node based, so pointers stay valid
+    };
+
+    void seed_link::join(const std::string& name) {
+        if (m_group || !name.empty()) {
+            seed_registry::instance().join(*this, name);
+        }
+    }
+
+}
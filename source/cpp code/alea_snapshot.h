@@ -0,0 +1,83 @@
+#pragma once
+
+#include "c74_min.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "alea_engine.h"
+#include "alea_state.h"
+
+// getstate / setstate glue: state words to and from Max lists, dicts and the
+// @snapshot attribute that pattr binds to. Words travel as 32-bit signed ints,
+// which every Max number type, dict and pattrstorage file keeps exactly.
+
+namespace alea {
+
+    inline c74::min::atoms state_atoms(const std::vector<uint32_t>& words) {
+        c74::min::atoms list;
+        list.reserve(words.size());
+        for (uint32_t w : words) {
+            list.push_back(static_cast<c74::max::t_atom_long>(static_cast<int32_t>(w)));
+        }
+        return list;
+    }
+
+    // What getstate sends: "state" followed by the words.
+    inline c74::min::atoms state_message(const std::vector<uint32_t>& words) {
+        c74::min::atoms message {c74::min::symbol("state")};
+        c74::min::atoms list = state_atoms(words);
+        message.insert(message.end(), list.begin(), list.end());
+        return message;
+    }
+
+    // The words of a setstate message: the words themselves, a "state" message
+    // as sent by getstate, or <dict> [key] for a state stored with getstate.
+    // Returns no words if the dict or key does not exist.
+    inline std::vector<uint32_t> state_words(const c74::min::atoms& args) {
+        std::vector<uint32_t> words;
+        size_t first = 0;
+        if (!args.empty() && args[0].a_type == c74::max::A_SYM) {
+            const c74::min::symbol name = args[0];
+            if (name == "state") {
+                first = 1;
+            } else {
+                c74::max::t_dictionary* d = c74::max::dictobj_findregistered_retain(name);
+                if (!d) {
+                    return words;
+                }
+                const c74::min::symbol key = args.size() > 1 ? static_cast<c74::min::symbol>(args[1]) : c74::min::symbol("state");
+                long count = 0;
+                c74::max::t_atom* list = nullptr;
+                if (c74::max::dictionary_getatoms(d, key, &count, &list) == c74::max::MAX_ERR_NONE) {
+                    words.reserve(static_cast<size_t>(count));
+                    for (long i = 0; i < count; ++i) {
+                        words.push_back(static_cast<uint32_t>(c74::max::atom_getlong(list + i)));
+                    }
+                }
+                c74::max::dictobj_release(d);
+                return words;
+            }
+        }
+        words.reserve(args.size() - first);
+        for (size_t i = first; i < args.size(); ++i) {
+            words.push_back(static_cast<uint32_t>(static_cast<c74::max::t_atom_long>(args[i])));
+        }
+        return words;
+    }
+
+    // getstate <dict> [key]: store the words under key ("state" by default).
+    inline bool state_to_dict(const c74::min::atoms& args, const std::vector<uint32_t>& words) {
+        const c74::min::symbol name = args[0];
+        c74::max::t_dictionary* d = c74::max::dictobj_findregistered_retain(name);
+        if (!d) {
+            return false;
+        }
+        const c74::min::symbol key = args.size() > 1 ? static_cast<c74::min::symbol>(args[1]) : c74::min::symbol("state");
+        c74::min::atoms list = state_atoms(words);
+        c74::max::dictionary_appendatoms(d, key, static_cast<long>(list.size()), list.data());
+        c74::max::dictobj_release(d);
+        return true;
+    }
+
+}
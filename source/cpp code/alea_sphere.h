@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+// Points and directions in 2 and 3 dimensions, written to out[0 .. dim).
+//
+// Uniform: the disk and ball by rejection from the square and the cube (4 in
+// pi and 6 in pi tries accepted); the circle and the sphere from a point
+// (p, q) of the disk, s = p^2 + q^2, with no trigonometry: ((p^2 - q^2) / s,
+// 2pq / s) doubles its angle, and (2p sqrt(1 - s), 2q sqrt(1 - s), 1 - 2s) is
+// Marsaglia's ("Choosing a point from the surface of a sphere", 1972).
+//
+// von Mises-Fisher directions, density proportional to exp(kappa mu.x) on the
+// unit circle or sphere (Wood, "Simulation of the von Mises Fisher
+// distribution", 1994): the component w along mu is drawn first, then a uniform
+// direction in the plane or line orthogonal to mu. On the sphere w has density
+// proportional to exp(kappa w) and is inverted in closed form; on the circle
+// it goes through Wood's rejection step, with Beta(1/2, 1/2) as p^2 / s from
+// a disk point, whose sign of q picks the side. Wood's constants and a
+// basis orthogonal to mu are set once per parameter change, in set(), and
+// both w and sqrt(1 - w^2) are worked out from 1 - w so that they keep their
+// precision for large kappa.
+//
+// Engine is anything with uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    // p^2 + q^2 < 1, returned
+    template<class Engine>
+    double disk_point(Engine& gen, double& p, double& q) {
+        for (;;) {
+            p = 2.0 * gen.uniform() - 1.0;
+            q = 2.0 * gen.uniform() - 1.0;
+            const double s = p * p + q * q;
+            if (s < 1.0 && s > 0.0) {
+                return s;
+            }
+        }
+    }
+
+    template<class Engine>
+    void uniform_disk(Engine& gen, double* out) {
+        disk_point(gen, out[0], out[1]);
+    }
+
+    template<class Engine>
+    void uniform_circle(Engine& gen, double* out) {
+        double p, q;
+        const double s = disk_point(gen, p, q);
+        out[0] = (p * p - q * q) / s;
+        out[1] = 2.0 * p * q / s;
+    }
+
+    template<class Engine>
+    void uniform_ball(Engine& gen, double* out) {
+        for (;;) {
+            const double x = 2.0 * gen.uniform() - 1.0;
+            const double y = 2.0 * gen.uniform() - 1.0;
+            const double z = 2.0 * gen.uniform() - 1.0;
+            if (x * x + y * y + z * z < 1.0) {
+                out[0] = x;
+                out[1] = y;
+                out[2] = z;
+                return;
+            }
+        }
+    }
+
+    template<class Engine>
+    void uniform_sphere(Engine& gen, double* out) {
+        double p, q;
+        const double s = disk_point(gen, p, q);
+        const double r = 2.0 * std::sqrt(1.0 - s);
+        out[0] = p * r;
+        out[1] = q * r;
+        out[2] = 1.0 - 2.0 * s;
+    }
+
+    class vmf_sampler {
+    public:
+        vmf_sampler(int dim = 3, double x = 1.0, double y = 0.0, double z = 0.0, double kappa = 1.0) {
+            set(dim, x, y, z, kappa);
+        }
+
+        // dim 2 (z unused) or 3, kappa >= 0. A mean direction of length 0 in the
+        // dimensions used gives the x axis.
+        void set(int dim, double x, double y, double z, double kappa) {
+            m_dim = dim == 2 ? 2 : 3;
+            if (m_dim == 2) {
+                z = 0.0;
+            }
+            const double length = std::sqrt(x * x + y * y + z * z);
+            if (length > 0.0) {
+                x /= length;
+                y /= length;
+                z /= length;
+            } else {
+                x = 1.0;
+                y = 0.0;
+                z = 0.0;
+            }
+            m_mu[0] = x;
+            m_mu[1] = y;
+            m_mu[2] = z;
+            m_kappa = kappa;
+
+            if (m_dim == 2) {
+                // e1: mu turned a quarter
+                m_e1[0] = -y;
+                m_e1[1] = x;
+                // Wood's b, x0 = (1 - b) / (1 + b) and the log terms, kept as
+                // 1 - x0 = 2b / (1 + b) and 1 - x0^2 = 4b / (1 + b)^2
+                m_b = 1.0 / (2.0 * kappa + std::sqrt(4.0 * kappa * kappa + 1.0));
+                m_x0 = (1.0 - m_b) / (1.0 + m_b);
+                m_one_minus_x0 = 2.0 * m_b / (1.0 + m_b);
+                m_log_one_minus_x0_sq = std::log(4.0 * m_b) - 2.0 * std::log1p(m_b);
+            } else {
+                // e1, e2: mu x (the axis least parallel to mu), then mu x e1
+                double ax[3] = {0.0, 0.0, 0.0};
+                const int k = std::fabs(x) <= std::fabs(y) && std::fabs(x) <= std::fabs(z) ? 0 : std::fabs(y) <= std::fabs(z) ? 1 : 2;
+                ax[k] = 1.0;
+                double e1[3] = {y * ax[2] - z * ax[1], z * ax[0] - x * ax[2], x * ax[1] - y * ax[0]};
+                const double n = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+                for (int i = 0; i < 3; ++i) {
+                    m_e1[i] = e1[i] / n;
+                }
+                m_e2[0] = y * m_e1[2] - z * m_e1[1];
+                m_e2[1] = z * m_e1[0] - x * m_e1[2];
+                m_e2[2] = x * m_e1[1] - y * m_e1[0];
+                m_expm1 = std::expm1(-2.0 * kappa);
+            }
+        }
+
+        int dim() const { return m_dim; }
+
+        template<class Engine>
+        void operator()(Engine& gen, double* out) const {
+            if (m_kappa <= 0.0) {
+                if (m_dim == 2) {
+                    uniform_circle(gen, out);
+                } else {
+                    uniform_sphere(gen, out);
+                }
+                return;
+            }
+            if (m_dim == 2) {
+                circle(gen, out);
+            } else {
+                sphere(gen, out);
+            }
+        }
+
+        // Batch path: n directions one after another, n * dim values.
+        template<class Engine>
+        void fill(Engine& gen, double* out, size_t n) const {
+            for (size_t i = 0; i < n; ++i) {
+                (*this)(gen, out + i * m_dim);
+            }
+        }
+
+    private:
+        template<class Engine>
+        void circle(Engine& gen, double* out) const {
+            for (;;) {
+                double p, q;
+                const double s = disk_point(gen, p, q);
+                const double beta = p * p / s;  // Beta(1/2, 1/2)
+                // t = 1 - w, w = (1 - (1 + b) beta) / (1 - (1 - b) beta)
+                const double t = 2.0 * m_b * beta / (1.0 - (1.0 - m_b) * beta);
+                // kappa (w - x0) + log(1 - x0 w) - log(1 - x0^2) >= log u
+                const double test = m_kappa * (m_one_minus_x0 - t) + std::log(m_one_minus_x0 + m_x0 * t) - m_log_one_minus_x0_sq;
+                if (test >= std::log(1.0 - gen.uniform())) {
+                    const double w = 1.0 - t;
+                    const double side = std::sqrt(t * (2.0 - t));
+                    const double v = q < 0.0 ? -side : side;
+                    out[0] = w * m_mu[0] + v * m_e1[0];
+                    out[1] = w * m_mu[1] + v * m_e1[1];
+                    return;
+                }
+            }
+        }
+
+        template<class Engine>
+        void sphere(Engine& gen, double* out) const {
+            // t = 1 - w, inverting the density of w, proportional to exp(kappa w) on [-1, 1]
+            const double u = 1.0 - gen.uniform();
+            const double t = -std::log1p((1.0 - u) * m_expm1) / m_kappa;
+            const double side = std::sqrt(std::max(0.0, t * (2.0 - t)));
+            double p, q;
+            const double s = disk_point(gen, p, q);
+            const double c = (p * p - q * q) / s * side;
+            const double d = 2.0 * p * q / s * side;
+            const double w = 1.0 - t;
+            for (int i = 0; i < 3; ++i) {
+                out[i] = w * m_mu[i] + c * m_e1[i] + d * m_e2[i];
+            }
+        }
+
+        int m_dim {3};
+        double m_mu[3] {1.0, 0.0, 0.0};
+        double m_e1[3] {0.0, 1.0, 0.0};
+        double m_e2[3] {0.0, 0.0, 1.0};
+        double m_kappa {1.0};
+        // circle: Wood's constants
+        double m_b {1.0};
+        double m_x0 {0.0};
+        double m_one_minus_x0 {1.0};
+        double m_log_one_minus_x0_sq {0.0};
+        // sphere: e^(-2 kappa) - 1
+        double m_expm1 {-1.0};
+    };
+
+}
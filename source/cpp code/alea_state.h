@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Flat encoding of engine and object state for getstate / setstate: a list of
+// 32-bit words, which Max lists, dicts and pattr all carry without loss.
+
+namespace alea {
+
+    class state_writer {
+    public:
+        void put(uint32_t w) { m_words.push_back(w); }
+
+        void put64(uint64_t w) {
+            put(static_cast<uint32_t>(w));
+            put(static_cast<uint32_t>(w >> 32));
+        }
+
+        void put_double(double d) {
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof bits);
+            put64(bits);
+        }
+
+        const std::vector<uint32_t>& words() const { return m_words; }
+
+    private:
+        std::vector<uint32_t> m_words;
+    };
+
+    // Readers do no bounds checks of their own: the engine checks the size of
+    // the whole state before reading any of it.
+    class state_reader {
+    public:
+        state_reader(const uint32_t* begin, const uint32_t* end)
+            : m_pos(begin)
+            , m_end(end) {}
+
+        explicit state_reader(const std::vector<uint32_t>& words)
+            : state_reader(words.data(), words.data() + words.size()) {}
+
+        size_t remaining() const { return static_cast<size_t>(m_end - m_pos); }
+        uint32_t peek() const { return *m_pos; }
+
+        uint32_t get() { return *m_pos++; }
+
+        uint64_t get64() {
+            uint64_t lo = get();
+            return lo | (static_cast<uint64_t>(get()) << 32);
+        }
+
+        double get_double() {
+            uint64_t bits = get64();
+            double d;
+            std::memcpy(&d, &bits, sizeof d);
+            return d;
+        }
+
+    private:
+        const uint32_t* m_pos;
+        const uint32_t* m_end;
+    };
+
+}
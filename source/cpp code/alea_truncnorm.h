@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "alea_normal.h"
+
+// Normal variates restricted to [low, high], by accept-reject with the proposal
+// chosen for the window (Robert, "Simulation of truncated normal variables",
+// 1995). On the standard scale, with the window mirrored so that it does not
+// lie left of 0:
+//
+// - a window around 0, at least sqrt(2 pi) wide: plain normals until one falls
+//   inside, accepted about half the time or more;
+// - a narrower window around 0, or a window in the tail with b^2 - a^2 <= 2: a
+//   uniform proposal, accepted with exp((m^2 - z^2) / 2), m the point of the
+//   window closest to 0;
+// - a wider window in the tail: an exponential from a with Robert's rate
+//   (a + sqrt(a^2 + 4)) / 2, truncated to the window by inversion, accepted
+//   with exp(-(z - rate)^2 / 2).
+//
+// Every case accepts at least a third of the proposals wherever the window
+// lies, so a value takes constant expected time, however narrow the window and
+// however far in the tail. set() picks the case once per parameter change.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class truncated_normal {
+    public:
+        truncated_normal(double mu = 0.0, double sigma = 1.0,
+                         double low = -std::numeric_limits<double>::infinity(),
+                         double high = std::numeric_limits<double>::infinity()) {
+            set(mu, sigma, low, high);
+        }
+
+        // sigma >= 0; the limits may come in either order and be infinite.
+        void set(double mu, double sigma, double low, double high) {
+            if (low > high) {
+                std::swap(low, high);
+            }
+            m_mu = mu;
+            m_sigma = std::fabs(sigma);
+            m_low = low;
+            m_high = high;
+            if (m_sigma == 0.0 || low == high) {
+                m_method = method::point;
+                return;
+            }
+            double a = (low - mu) / m_sigma;
+            double b = (high - mu) / m_sigma;
+            m_flip = b <= 0.0;
+            if (m_flip) {
+                const double t = a;
+                a = -b;
+                b = -t;
+            }
+            m_a = a;
+            m_b = b;
+            if (a < 0.0) {
+                m_method = b - a >= sqrt_2pi ? method::normal : method::uniform;
+                m_width = b - a;
+            } else if (b == std::numeric_limits<double>::infinity() || (b - a) * (b + a) > 2.0) {
+                m_method = method::exponential;
+                m_rate = 0.5 * (a + std::sqrt(a * a + 4.0));
+                m_mass = -std::expm1(-m_rate * (b - a));  // share of the exponential inside the window
+            } else {
+                m_method = method::uniform;
+                m_width = b - a;
+            }
+        }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_method == method::point) {
+                return std::min(m_high, std::max(m_low, m_mu));
+            }
+            double z = standard(gen);
+            if (m_flip) {
+                z = -z;
+            }
+            const double scaled = m_sigma * z;
+            // rounding in mu + sigma z must not step outside the limits
+            return std::min(m_high, std::max(m_low, m_mu + scaled));
+        }
+
+    private:
+        static constexpr double sqrt_2pi = 2.5066282746310002;
+
+        enum class method { point, normal, uniform, exponential };
+
+        template<class Engine>
+        double standard(Engine& gen) const {
+            switch (m_method) {
+                case method::normal:
+                    for (;;) {
+                        const double z = normal(gen);
+                        if (z >= m_a && z <= m_b) {
+                            return z;
+                        }
+                    }
+                case method::uniform:
+                    for (;;) {
+                        const double z = m_a + m_width * gen.uniform();
+                        // m^2 - z^2 with m = max(a, 0), factored against cancellation far out
+                        const double m = std::max(m_a, 0.0);
+                        if (gen.uniform() <= std::exp(-0.5 * (z - m) * (z + m))) {
+                            return z;
+                        }
+                    }
+                default:
+                    for (;;) {
+                        const double z = m_a - std::log1p(-m_mass * gen.uniform()) / m_rate;
+                        const double d = z - m_rate;
+                        if (gen.uniform() <= std::exp(-0.5 * d * d)) {
+                            return z;
+                        }
+                    }
+            }
+        }
+
+        double m_mu {0.0};
+        double m_sigma {1.0};
+        double m_low {0.0};
+        double m_high {0.0};
+        method m_method {method::normal};
+        bool m_flip {false};  // window left of 0: sample its mirror image and negate
+        double m_a {0.0};     // standardized window, a < b, b > 0
+        double m_b {0.0};
+        double m_width {0.0};
+        double m_rate {1.0};
+        double m_mass {1.0};
+    };
+
+}
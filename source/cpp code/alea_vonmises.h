@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "alea_icdf.h"
+
+// von Mises angles (Best and Fisher, "Efficient simulation of the von Mises
+// distribution", 1979) with the envelope constant r computed once per kappa,
+// in set().
+//
+// cap(n) bounds the rejection loop for real-time use: after n trials the angle
+// is read from a quantile table of the current kappa, and counted in
+// fallbacks(). Under a cap set() and cap() build the table, so that an angle
+// never does.
+//
+// Engine is anything with next64() and uniform() in [0, 1), like alea::engine.
+
+namespace alea {
+
+    class vonmises_sampler {
+    public:
+        vonmises_sampler(double mu = M_PI, double kappa = 2.0) { set(mu, kappa); }
+
+        // kappa <= 0 gives uniform angles in [0, 2pi)
+        void set(double mu, double kappa) {
+            m_mu = mu;
+            m_kappa = kappa;
+            if (kappa > 0) {
+                double a = 1.0 + std::sqrt(1.0 + 4.0 * kappa * kappa);
+                // (a - sqrt(2a)) / 2kappa without the cancellation, which made b 0
+                // and every trial fail for kappa below about 1e-8
+                double b = 2.0 * kappa / (a + std::sqrt(2.0 * a));
+                m_r = (1.0 + b * b) / (2.0 * b);
+            }
+            prepare_fallback();
+        }
+
+        // At most max_tries trials per value, 0 for no limit.
+        void cap(int max_tries) {
+            m_max_tries = std::max(0, max_tries);
+            prepare_fallback();
+            m_fallbacks = 0;
+        }
+
+        // Values read from the table since the last cap().
+        unsigned long fallbacks() const { return m_fallbacks; }
+
+        template<class Engine>
+        double operator()(Engine& gen) const {
+            if (m_kappa <= 0) {
+                return 2.0 * M_PI * gen.uniform();
+            }
+            for (int tries = 0; m_max_tries == 0 || tries < m_max_tries; ++tries) {
+                double u1 = gen.uniform();
+                double z = std::cos(M_PI * u1);
+                double f = (1.0 + m_r * z) / (m_r + z);
+                double c = m_kappa * (m_r - f);
+
+                double u2 = gen.uniform();
+                if (u2 < c * (2.0 - c) || u2 <= c * std::exp(1.0 - c)) {
+                    double u3 = gen.uniform();
+                    return angle(f, u3 > 0.5);
+                }
+            }
+            return fallback(gen);
+        }
+
+        // n angles at once. Candidates are drawn a block at a time and tested in a
+        // loop without branches, which the compiler can vectorize; accepted ones
+        // are then packed into out in order. The side of mu comes from the low
+        // bit of the draw that gives u1, so a candidate costs two draws, not three.
+        // Under a cap, the angles are drawn one by one so each has its own bound.
+        template<class Engine>
+        void fill(Engine& gen, double* out, size_t n) const {
+            if (m_max_tries > 0 && m_kappa > 0) {
+                for (size_t k = 0; k < n; ++k) {
+                    out[k] = (*this)(gen);
+                }
+                return;
+            }
+            if (m_kappa <= 0) {
+                for (size_t k = 0; k < n; ++k) {
+                    out[k] = 2.0 * M_PI * gen.uniform();
+                }
+                return;
+            }
+            constexpr size_t block = 64;
+            double u1[block], u2[block], f[block];
+            uint8_t side[block], accept[block];
+            size_t done = 0;
+            while (done < n) {
+                // a trial accepts with probability above 0.65, so draw for what is left
+                const size_t count = std::min(block, (n - done) * 3 / 2 + 4);
+                for (size_t i = 0; i < count; ++i) {
+                    const uint64_t bits = gen.next64();
+                    u1[i] = static_cast<double>(bits >> 11) * 0x1.0p-53;
+                    side[i] = static_cast<uint8_t>(bits & 1u);
+                    u2[i] = gen.uniform();
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    const double z = std::cos(M_PI * u1[i]);
+                    const double fi = (1.0 + m_r * z) / (m_r + z);
+                    const double c = m_kappa * (m_r - fi);
+                    f[i] = fi;
+                    accept[i] = static_cast<uint8_t>((u2[i] < c * (2.0 - c)) | (u2[i] <= c * std::exp(1.0 - c)));
+                }
+                for (size_t i = 0; i < count && done < n; ++i) {
+                    if (accept[i]) {
+                        out[done++] = angle(f[i], side[i]);
+                    }
+                }
+            }
+        }
+
+    private:
+        // The density exp(kappa cos y) around mu, over 12 standard deviations
+        // when it is concentrated enough for that to be less than the circle.
+        void prepare_fallback() {
+            if (m_max_tries == 0 || m_kappa <= 0) {
+                m_fallback = quantile_table();
+                return;
+            }
+            const double kappa = m_kappa;
+            const double half = std::min(M_PI, 12.0 / std::sqrt(kappa));
+            m_fallback = quantile_table([kappa](double y) { return kappa * std::cos(y); }, -half, half,
+                                        [](double y) { return y; });
+        }
+
+        template<class Engine>
+        double fallback(Engine& gen) const {
+            ++m_fallbacks;
+            return std::fmod(m_mu + m_fallback(gen.uniform()), 2.0 * M_PI);
+        }
+
+        double angle(double f, bool above) const {
+            return std::fmod(above ? m_mu + std::acos(f) : m_mu - std::acos(f), 2.0 * M_PI);
+        }
+
+        double m_mu {M_PI};
+        double m_kappa {2.0};
+        double m_r {1.0};
+        int m_max_tries {0};
+        quantile_table m_fallback;  // for the current kappa, under a cap
+        mutable unsigned long m_fallbacks {0};
+    };
+
+}